@@ -36,6 +36,7 @@ public class AssetStreamingManager : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"AssetRegistry",
 				"Slate",
 				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
@@ -1,4 +1,6 @@
 #include "AssetStreamingCallbackHelper.h"
+#include "AssetStreamingSubsystem.h"
+#include "Engine/Engine.h"
 
 void UAssetStreamingCallbackWrapper::SetCallback(FOnAssetLoadedDelegate InDelegate)
 {
@@ -13,10 +15,15 @@ void UAssetStreamingCallbackWrapper::OnAssetLoaded_Implementation(const TSoftObj
     }
 }
 
-TScriptInterface<IAssetStreamingCallback> FStreamingCallbackHelper::MakeCallback(UObject* Outer, UAssetStreamingCallbackWrapper::FOnAssetLoadedDelegate Delegate)
+TScriptInterface<IAssetStreamingCallback> FStreamingCallbackHelper::MakeCallback(UAssetStreamingCallbackWrapper::FOnAssetLoadedDelegate Delegate)
 {
-    UAssetStreamingCallbackWrapper* CallbackObj = NewObject<UAssetStreamingCallbackWrapper>(Outer ? Outer : GetTransientPackage());
-    CallbackObj->AddToRoot(); // GC 
+    UAssetStreamingSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<UAssetStreamingSubsystem>() : nullptr;
+    if (!Subsystem)
+    {
+        return TScriptInterface<IAssetStreamingCallback>();
+    }
+
+    UAssetStreamingCallbackWrapper* CallbackObj = Subsystem->AcquireCallbackWrapper();
     CallbackObj->SetCallback(Delegate);
 
     TScriptInterface<IAssetStreamingCallback> Interface;
@@ -0,0 +1,131 @@
+#include "AssetStreamingManifest.h"
+#include "AssetStreamingManagerDebug.h"
+
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace AssetPreloadManifest
+{
+    static constexpr uint32 Magic = 0x41534D46; // 'ASMF'
+    static constexpr int32 Version = 1;
+}
+
+bool FAssetPreloadManifest::Save(const FString& Filename)
+{
+    TArray<uint8> Payload;
+    FMemoryWriter PayloadWriter(Payload);
+    Serialize(PayloadWriter);
+
+    int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Payload.Num());
+    TArray<uint8> Compressed;
+    Compressed.SetNumUninitialized(CompressedSize);
+    if (!FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Payload.GetData(), Payload.Num()))
+    {
+        UE_LOG(LogAssetStreamingManager, Warning, TEXT("Preload manifest: Failed to compress '%s'."), *Filename);
+        return false;
+    }
+    Compressed.SetNum(CompressedSize, EAllowShrinking::No);
+
+    TArray<uint8> FileData;
+    FMemoryWriter FileWriter(FileData);
+    uint32 Magic = AssetPreloadManifest::Magic;
+    int32 Version = AssetPreloadManifest::Version;
+    int32 UncompressedSize = Payload.Num();
+    FileWriter << Magic << Version << UncompressedSize;
+    FileWriter.Serialize(Compressed.GetData(), Compressed.Num());
+
+    return FFileHelper::SaveArrayToFile(FileData, *Filename);
+}
+
+bool FAssetPreloadManifest::Load(const FString& Filename)
+{
+    Reset();
+
+    TArray<uint8> FileData;
+    if (!FFileHelper::LoadFileToArray(FileData, *Filename, FILEREAD_Silent))
+    {
+        return false;
+    }
+
+    FMemoryReader FileReader(FileData);
+    uint32 Magic = 0;
+    int32 Version = 0;
+    int32 UncompressedSize = 0;
+    FileReader << Magic << Version << UncompressedSize;
+    if (FileReader.IsError() || Magic != AssetPreloadManifest::Magic || Version != AssetPreloadManifest::Version || UncompressedSize < 0)
+    {
+        UE_LOG(LogAssetStreamingManager, Warning, TEXT("Preload manifest: '%s' is not a version %d manifest, ignored."), *Filename, AssetPreloadManifest::Version);
+        return false;
+    }
+
+    const int64 HeaderSize = FileReader.Tell();
+    TArray<uint8> Payload;
+    Payload.SetNumUninitialized(UncompressedSize);
+    if (!FCompression::UncompressMemory(NAME_Zlib, Payload.GetData(), UncompressedSize, FileData.GetData() + HeaderSize, FileData.Num() - HeaderSize))
+    {
+        UE_LOG(LogAssetStreamingManager, Warning, TEXT("Preload manifest: Failed to decompress '%s'."), *Filename);
+        return false;
+    }
+
+    FMemoryReader PayloadReader(Payload);
+    Serialize(PayloadReader);
+    if (PayloadReader.IsError())
+    {
+        Reset();
+        return false;
+    }
+    return true;
+}
+
+void FAssetPreloadManifest::Reset()
+{
+    MapName = NAME_None;
+    Route = NAME_None;
+    Entries.Reset();
+}
+
+FString FAssetPreloadManifest::GetManifestPath(const FName MapName, const FName Route)
+{
+    const FString RouteName = Route.IsNone() ? TEXT("Default") : Route.ToString();
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AssetStreaming"), TEXT("Manifests"), FString::Printf(TEXT("%s_%s.asmanifest"), *MapName.ToString(), *RouteName));
+}
+
+FString FAssetPreloadManifest::GetWarmSetPath(const FName MapName)
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AssetStreaming"), TEXT("Manifests"), FString::Printf(TEXT("%s.aswarmset"), *MapName.ToString()));
+}
+
+void FAssetPreloadManifest::Serialize(FArchive& Ar)
+{
+    // Paths are stored as strings, the manifest is not a package and must not go through soft object path fixups
+    FString MapString = MapName.ToString();
+    FString RouteString = Route.ToString();
+    Ar << MapString << RouteString;
+
+    int32 EntryCount = Entries.Num();
+    Ar << EntryCount;
+    if (Ar.IsLoading())
+    {
+        MapName = FName(*MapString);
+        Route = FName(*RouteString);
+        if (EntryCount < 0 || EntryCount > Ar.TotalSize())
+        {
+            Ar.SetError();
+            return;
+        }
+        Entries.SetNum(EntryCount);
+    }
+
+    for (FAssetPreloadManifestEntry& Entry : Entries)
+    {
+        FString Path = Entry.AssetPath.ToString();
+        Ar << Path << Entry.TimeSeconds << Entry.Progress;
+        if (Ar.IsLoading())
+        {
+            Entry.AssetPath = FSoftObjectPath(Path);
+        }
+    }
+}
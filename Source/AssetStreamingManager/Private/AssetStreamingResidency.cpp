@@ -0,0 +1,208 @@
+#include "AssetStreamingResidency.h"
+
+FAssetStreamingResidency::FAssetStreamingResidency(const int32 InCategoryCount)
+{
+    SetCategoryCount(InCategoryCount);
+}
+
+void FAssetStreamingResidency::SetCategoryCount(const int32 InCategoryCount)
+{
+    Empty();
+    Categories.Reset();
+    Categories.SetNum(FMath::Max(InCategoryCount, 1));
+}
+
+void FAssetStreamingResidency::SetBudget(const int32 Category, const int64 BudgetBytes)
+{
+    if (Categories.IsValidIndex(Category))
+    {
+        Categories[Category].BudgetBytes = FMath::Max<int64>(BudgetBytes, 0);
+    }
+}
+
+void FAssetStreamingResidency::Add(const FSoftObjectPath& Path, const int32 Category, const int64 Bytes)
+{
+    if (NodeLookup.Contains(Path))
+    {
+        MarkRequested(Path);
+        return;
+    }
+
+    const int32 NodeIndex = FreeNodes.Num() > 0 ? FreeNodes.Pop(EAllowShrinking::No) : Nodes.AddDefaulted();
+    FResidentNode& Node = Nodes[NodeIndex];
+    Node.Path = Path;
+    Node.Bytes = FMath::Max<int64>(Bytes, 0);
+    Node.Category = Categories.IsValidIndex(Category) ? Category : Categories.Num() - 1;
+    Node.bMeasured = false;
+    Node.bReleased = false;
+    NodeLookup.Add(Path, NodeIndex);
+
+    FCategory& CategoryState = Categories[Node.Category];
+    CategoryState.ResidentBytes += Node.Bytes;
+    CategoryState.PeakResidentBytes = FMath::Max(CategoryState.PeakResidentBytes, CategoryState.ResidentBytes);
+    ++CategoryState.ResidentCount;
+}
+
+void FAssetStreamingResidency::Remove(const FSoftObjectPath& Path)
+{
+    int32 NodeIndex = INDEX_NONE;
+    if (!NodeLookup.RemoveAndCopyValue(Path, NodeIndex))
+    {
+        return;
+    }
+
+    FResidentNode& Node = Nodes[NodeIndex];
+    if (Node.bReleased)
+    {
+        Unlink(NodeIndex);
+    }
+
+    FCategory& CategoryState = Categories[Node.Category];
+    CategoryState.ResidentBytes -= Node.Bytes;
+    --CategoryState.ResidentCount;
+
+    Node.Path.Reset();
+    Node.Bytes = 0;
+    FreeNodes.Add(NodeIndex);
+}
+
+bool FAssetStreamingResidency::SetMeasuredBytes(const FSoftObjectPath& Path, const int64 Bytes)
+{
+    const int32* NodeIndex = NodeLookup.Find(Path);
+    if (!NodeIndex)
+    {
+        return false;
+    }
+
+    FResidentNode& Node = Nodes[*NodeIndex];
+    FCategory& CategoryState = Categories[Node.Category];
+    CategoryState.ResidentBytes += FMath::Max<int64>(Bytes, 0) - Node.Bytes;
+    CategoryState.PeakResidentBytes = FMath::Max(CategoryState.PeakResidentBytes, CategoryState.ResidentBytes);
+    Node.Bytes = FMath::Max<int64>(Bytes, 0);
+    Node.bMeasured = true;
+    return true;
+}
+
+bool FAssetStreamingResidency::IsMeasured(const FSoftObjectPath& Path) const
+{
+    const int32* NodeIndex = NodeLookup.Find(Path);
+    return NodeIndex && Nodes[*NodeIndex].bMeasured;
+}
+
+void FAssetStreamingResidency::MarkReleased(const FSoftObjectPath& Path)
+{
+    const int32* NodeIndex = NodeLookup.Find(Path);
+    if (!NodeIndex)
+    {
+        return;
+    }
+
+    // Released again, moves to the most recently used end
+    if (Nodes[*NodeIndex].bReleased)
+    {
+        Unlink(*NodeIndex);
+    }
+    Link(*NodeIndex);
+}
+
+void FAssetStreamingResidency::MarkRequested(const FSoftObjectPath& Path)
+{
+    const int32* NodeIndex = NodeLookup.Find(Path);
+    if (NodeIndex && Nodes[*NodeIndex].bReleased)
+    {
+        Unlink(*NodeIndex);
+    }
+}
+
+void FAssetStreamingResidency::GatherEvictions(TArray<FSoftObjectPath>& OutEvicted) const
+{
+    for (const FCategory& CategoryState : Categories)
+    {
+        int64 ResidentBytes = CategoryState.ResidentBytes;
+        for (int32 NodeIndex = CategoryState.LruHead; NodeIndex != INDEX_NONE && CategoryState.BudgetBytes > 0 && ResidentBytes > CategoryState.BudgetBytes; NodeIndex = Nodes[NodeIndex].Next)
+        {
+            OutEvicted.Add(Nodes[NodeIndex].Path);
+            ResidentBytes -= Nodes[NodeIndex].Bytes;
+        }
+    }
+}
+
+void FAssetStreamingResidency::RecordEvicted(const FSoftObjectPath& Path)
+{
+    if (const int32* NodeIndex = NodeLookup.Find(Path))
+    {
+        ++Categories[Nodes[*NodeIndex].Category].EvictionCount;
+    }
+}
+
+void FAssetStreamingResidency::ResetPeaks()
+{
+    for (FCategory& CategoryState : Categories)
+    {
+        CategoryState.PeakResidentBytes = CategoryState.ResidentBytes;
+        CategoryState.EvictionCount = 0;
+    }
+}
+
+void FAssetStreamingResidency::Empty()
+{
+    Nodes.Empty();
+    FreeNodes.Empty();
+    NodeLookup.Empty();
+    for (FCategory& CategoryState : Categories)
+    {
+        const int64 BudgetBytes = CategoryState.BudgetBytes;
+        CategoryState = FCategory();
+        CategoryState.BudgetBytes = BudgetBytes;
+    }
+}
+
+void FAssetStreamingResidency::Link(const int32 NodeIndex)
+{
+    FResidentNode& Node = Nodes[NodeIndex];
+    FCategory& CategoryState = Categories[Node.Category];
+
+    Node.Prev = CategoryState.LruTail;
+    Node.Next = INDEX_NONE;
+    if (CategoryState.LruTail != INDEX_NONE)
+    {
+        Nodes[CategoryState.LruTail].Next = NodeIndex;
+    }
+    else
+    {
+        CategoryState.LruHead = NodeIndex;
+    }
+    CategoryState.LruTail = NodeIndex;
+
+    Node.bReleased = true;
+    ++CategoryState.ReleasedCount;
+}
+
+void FAssetStreamingResidency::Unlink(const int32 NodeIndex)
+{
+    FResidentNode& Node = Nodes[NodeIndex];
+    FCategory& CategoryState = Categories[Node.Category];
+
+    if (Node.Prev != INDEX_NONE)
+    {
+        Nodes[Node.Prev].Next = Node.Next;
+    }
+    else
+    {
+        CategoryState.LruHead = Node.Next;
+    }
+
+    if (Node.Next != INDEX_NONE)
+    {
+        Nodes[Node.Next].Prev = Node.Prev;
+    }
+    else
+    {
+        CategoryState.LruTail = Node.Prev;
+    }
+
+    Node.Prev = INDEX_NONE;
+    Node.Next = INDEX_NONE;
+    Node.bReleased = false;
+    --CategoryState.ReleasedCount;
+}
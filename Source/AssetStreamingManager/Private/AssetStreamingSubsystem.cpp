@@ -1,11 +1,52 @@
 #include "AssetStreamingSubsystem.h"
 #include "AssetStreamingManagerDebug.h"
 
+#include "Algo/StableSort.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "Engine/Engine.h"
 #include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/PackageName.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 #include "TimerManager.h"
+#include "Trace/Trace.inl"
 #include "UObject/SoftObjectPtr.h"
+#include "UObject/UObjectHash.h"
 
 DECLARE_CYCLE_STAT(TEXT("AssetStreamingManager Tick"), STAT_ASMTick, STATGROUP_AssetStreamingManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pending Requests"), STAT_ASMPendingRequests, STATGROUP_AssetStreamingManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Default Queue Depth"), STAT_ASMDefaultQueueDepth, STATGROUP_AssetStreamingManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Priority Queue Depth"), STAT_ASMPriorityQueueDepth, STATGROUP_AssetStreamingManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("In-Flight Requests"), STAT_ASMInFlightRequests, STATGROUP_AssetStreamingManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pending Unloads"), STAT_ASMPendingUnloads, STATGROUP_AssetStreamingManager);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("In-Flight MB (estimated)"), STAT_ASMInFlightMB, STATGROUP_AssetStreamingManager);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Request Latency P50 (ms)"), STAT_ASMLatencyP50, STATGROUP_AssetStreamingManager);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Request Latency P95 (ms)"), STAT_ASMLatencyP95, STATGROUP_AssetStreamingManager);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Request Latency P99 (ms)"), STAT_ASMLatencyP99, STATGROUP_AssetStreamingManager);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Loaded KB/s (estimated)"), STAT_ASMLoadedKBPerSecond, STATGROUP_AssetStreamingManager);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Resident MB (estimated)"), STAT_ASMResidentMB, STATGROUP_AssetStreamingManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Budget Evictions"), STAT_ASMBudgetEvictions, STATGROUP_AssetStreamingManager);
+
+CSV_DEFINE_CATEGORY(AssetStreamingManager, true);
+
+TRACE_DECLARE_INT_COUNTER(AssetStreaming_PendingRequests, TEXT("AssetStreaming/PendingRequests"));
+TRACE_DECLARE_INT_COUNTER(AssetStreaming_InFlightRequests, TEXT("AssetStreaming/InFlightRequests"));
+TRACE_DECLARE_INT_COUNTER(AssetStreaming_LoadedBytesPerSecond, TEXT("AssetStreaming/LoadedBytesPerSecond"));
+
+#if UE_TRACE_ENABLED
+UE_TRACE_CHANNEL_DEFINE(AssetStreamingChannel)
+
+UE_TRACE_EVENT_BEGIN(AssetStreaming, RequestLoaded)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(double, LatencySeconds)
+    UE_TRACE_EVENT_FIELD(int32, Priority)
+    UE_TRACE_EVENT_FIELD(int64, Bytes)
+    UE_TRACE_EVENT_FIELD(bool, bAlreadyLoaded)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, AssetPath)
+UE_TRACE_EVENT_END()
+#endif
 
 namespace StreamingManager
 {
@@ -27,17 +68,224 @@ namespace StreamingManager
         , TEXT("Maximum number of assets that can be loaded at once per tick")
         , ECVF_ReadOnly);
 
+    int32 AsyncLoadPriorityMin = FStreamableManager::DefaultAsyncLoadPriority;
+    FAutoConsoleVariableRef CVarAsyncLoadPriorityMin(TEXT("StreamingManager.AsyncLoadPriorityMin")
+        , AsyncLoadPriorityMin
+        , TEXT("Async load priority used for default queue requests (Priority <= 0)")
+        , ECVF_Default);
+
+    int32 AsyncLoadPriorityMax = FStreamableManager::AsyncLoadHighPriority;
+    FAutoConsoleVariableRef CVarAsyncLoadPriorityMax(TEXT("StreamingManager.AsyncLoadPriorityMax")
+        , AsyncLoadPriorityMax
+        , TEXT("Async load priority used for requests in the highest priority group")
+        , ECVF_Default);
+
+    float AsyncLoadPriorityExponent = 1.0f;
+    FAutoConsoleVariableRef CVarAsyncLoadPriorityExponent(TEXT("StreamingManager.AsyncLoadPriorityExponent")
+        , AsyncLoadPriorityExponent
+        , TEXT("Curve between Min and Max async load priority. 1 is linear, > 1 keeps most requests near Min and only the top groups near Max")
+        , ECVF_Default);
+
+    bool bPrefetchDependencies = false;
+    FAutoConsoleVariableRef CVarPrefetchDependencies(TEXT("StreamingManager.bPrefetchDependencies")
+        , bPrefetchDependencies
+        , TEXT("Query the asset registry for hard package dependencies of a requested asset and issue them together at the same priority")
+        , ECVF_Default);
+
+    int32 PrefetchDependencyDepth = 2;
+    FAutoConsoleVariableRef CVarPrefetchDependencyDepth(TEXT("StreamingManager.PrefetchDependencyDepth")
+        , PrefetchDependencyDepth
+        , TEXT("How many levels of hard dependencies are prefetched, 1 is direct dependencies only")
+        , ECVF_Default);
+
+    int32 MaxDependencyCacheEntries = 4096;
+    FAutoConsoleVariableRef CVarMaxDependencyCacheEntries(TEXT("StreamingManager.MaxDependencyCacheEntries")
+        , MaxDependencyCacheEntries
+        , TEXT("Requested packages whose flattened dependencies are cached, the cache starts over once full")
+        , ECVF_Default);
+
+    int32 MaxStaleQueueEntries = 1024;
+    FAutoConsoleVariableRef CVarMaxStaleQueueEntries(TEXT("StreamingManager.MaxStaleQueueEntries")
+        , MaxStaleQueueEntries
+        , TEXT("Number of cancelled/reprioritized queue entries tolerated before the pending queues are compacted")
+        , ECVF_Default);
+
+    int32 CriticalPriority = 50;
+    FAutoConsoleVariableRef CVarCriticalPriority(TEXT("StreamingManager.CriticalPriority")
+        , CriticalPriority
+        , TEXT("Requests at or above this priority are in the Critical class, which has no in-flight limits by default")
+        , ECVF_Default);
+
+    int32 UnknownAssetSizeKB = 512;
+    FAutoConsoleVariableRef CVarUnknownAssetSizeKB(TEXT("StreamingManager.UnknownAssetSizeKB")
+        , UnknownAssetSizeKB
+        , TEXT("Size charged against the in-flight byte budget for packages the asset registry has no size for")
+        , ECVF_Default);
+
+    int32 BurstLoadMultiplier = 4;
+    FAutoConsoleVariableRef CVarBurstLoadMultiplier(TEXT("StreamingManager.BurstLoadMultiplier")
+        , BurstLoadMultiplier
+        , TEXT("MaxAssetsToLoadPerTick is multiplied by this in Burst streaming mode")
+        , ECVF_Default);
+
+    float DistancePriorityFalloff = 200000.f;
+    FAutoConsoleVariableRef CVarDistancePriorityFalloff(TEXT("StreamingManager.DistancePriorityFalloff")
+        , DistancePriorityFalloff
+        , TEXT("Distance in cm at which a spatial request falls to priority 0 (default queue), priority drops linearly up to it")
+        , ECVF_Default);
+
+    int32 DistancePriorityUpdatesPerTick = 256;
+    FAutoConsoleVariableRef CVarDistancePriorityUpdatesPerTick(TEXT("StreamingManager.DistancePriorityUpdatesPerTick")
+        , DistancePriorityUpdatesPerTick
+        , TEXT("Maximum number of spatial requests whose priority is re-evaluated per tick")
+        , ECVF_Default);
+
+    float SyncLoadTimeoutSeconds = 0.25f;
+    FAutoConsoleVariableRef CVarSyncLoadTimeoutSeconds(TEXT("StreamingManager.SyncLoadTimeoutSeconds")
+        , SyncLoadTimeoutSeconds
+        , TEXT("LoadAssetSync during async loading waits this long for the asset's own package before falling back to a full blocking load")
+        , ECVF_Default);
+
+    bool bRecordPreloadManifest = false;
+    FAutoConsoleVariableRef CVarRecordPreloadManifest(TEXT("StreamingManager.Preload.bRecord")
+        , bRecordPreloadManifest
+        , TEXT("Record the assets requested per map and route into Saved/AssetStreaming/Manifests")
+        , ECVF_Default);
+
+    bool bReplayPreloadManifest = false;
+    FAutoConsoleVariableRef CVarReplayPreloadManifest(TEXT("StreamingManager.Preload.bReplay")
+        , bReplayPreloadManifest
+        , TEXT("Prefetch the recorded assets of the loaded map and route ahead of player progress, in the default queue")
+        , ECVF_Default);
+
+    float PreloadLookahead = 10.f;
+    FAutoConsoleVariableRef CVarPreloadLookahead(TEXT("StreamingManager.Preload.Lookahead")
+        , PreloadLookahead
+        , TEXT("How far ahead of the current progress (seconds by default) recorded assets are prefetched")
+        , ECVF_Default);
+
+    float PreloadRetain = 30.f;
+    FAutoConsoleVariableRef CVarPreloadRetain(TEXT("StreamingManager.Preload.Retain")
+        , PreloadRetain
+        , TEXT("How long after its recorded progress a prefetched asset is kept requested before it is released")
+        , ECVF_Default);
+
+    bool bWarmSet = true;
+    FAutoConsoleVariableRef CVarWarmSet(TEXT("StreamingManager.WarmSet.bEnabled")
+        , bWarmSet
+        , TEXT("Load the warm set of a map while it is loading and capture it from the first seconds of gameplay")
+        , ECVF_Default);
+
+    float WarmSetCaptureSeconds = 5.f;
+    FAutoConsoleVariableRef CVarWarmSetCaptureSeconds(TEXT("StreamingManager.WarmSet.CaptureSeconds")
+        , WarmSetCaptureSeconds
+        , TEXT("Assets first requested within this many seconds after a map loaded make up its captured warm set")
+        , ECVF_Default);
+
+    int32 WarmSetMaxAssets = 1024;
+    FAutoConsoleVariableRef CVarWarmSetMaxAssets(TEXT("StreamingManager.WarmSet.MaxAssets")
+        , WarmSetMaxAssets
+        , TEXT("Maximum number of assets captured in a warm set")
+        , ECVF_Default);
+
+    float WarmSetRetainSeconds = 10.f;
+    FAutoConsoleVariableRef CVarWarmSetRetainSeconds(TEXT("StreamingManager.WarmSet.RetainSeconds")
+        , WarmSetRetainSeconds
+        , TEXT("Seconds a loaded warm set is kept requested, gameplay is expected to have requested what it needs by then")
+        , ECVF_Default);
+
+    static const FName CategoryTagName(TEXT("AssetStreamingCategory"));
+    static const FName OtherCategoryName(TEXT("Other"));
+
+    static TArray<FAssetStreamingCategory> GetDefaultStreamingCategories()
+    {
+        auto MakeCategory = [](const TCHAR* Name, const int32 BudgetMB, std::initializer_list<const TCHAR*> ClassPaths)
+            {
+                FAssetStreamingCategory Category;
+                Category.Name = FName(Name);
+                Category.BudgetMB = BudgetMB;
+                for (const TCHAR* ClassPath : ClassPaths)
+                {
+                    Category.AssetClasses.Emplace(ClassPath);
+                }
+                return Category;
+            };
+
+        return {
+            MakeCategory(TEXT("Texture"), 512, { TEXT("/Script/Engine.Texture2D"), TEXT("/Script/Engine.TextureCube"), TEXT("/Script/Engine.Texture2DArray"), TEXT("/Script/Engine.VolumeTexture") }),
+            MakeCategory(TEXT("Mesh"), 512, { TEXT("/Script/Engine.StaticMesh"), TEXT("/Script/Engine.SkeletalMesh") }),
+            MakeCategory(TEXT("Audio"), 64, { TEXT("/Script/Engine.SoundWave"), TEXT("/Script/Engine.SoundCue"), TEXT("/Script/MetasoundEngine.MetaSoundSource") }),
+            MakeCategory(TEXT("Animation"), 128, { TEXT("/Script/Engine.AnimSequence"), TEXT("/Script/Engine.AnimMontage"), TEXT("/Script/Engine.BlendSpace") }),
+        };
+    }
+
+    static FName GetMapShortName(const FString& MapPackageName)
+    {
+        return FName(*FPackageName::GetShortName(UWorld::RemovePIEPrefix(MapPackageName)));
+    }
+
 	bool bForceLoadComplete = false;
     FAutoConsoleVariable CVarbForceLoadComplete(TEXT("StreamingManager.bForceImmediateLoadComplete")
         , bForceLoadComplete
         , TEXT("Force handle completion for test")
         , ECVF_Default);
+
+    FAutoConsoleCommandWithOutputDevice CmdDumpQueues(TEXT("StreamingManager.DumpQueues")
+        , TEXT("Logs the pending queues, in-flight requests, latency percentiles per priority group and throughput")
+        , FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+            {
+                if (const UAssetStreamingSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<UAssetStreamingSubsystem>() : nullptr)
+                {
+                    Subsystem->DumpQueues(Ar);
+                }
+            }));
+
+    FAutoConsoleCommand CmdSetMode(TEXT("StreamingManager.SetMode")
+        , TEXT("Sets the streaming mode: Background, Normal or Burst")
+        , FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+            {
+                UAssetStreamingSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<UAssetStreamingSubsystem>() : nullptr;
+                const int64 Mode = Args.Num() > 0 ? StaticEnum<EAssetStreamingMode>()->GetValueByNameString(Args[0]) : INDEX_NONE;
+                if (Subsystem && Mode != INDEX_NONE)
+                {
+                    Subsystem->SetStreamingMode(static_cast<EAssetStreamingMode>(Mode));
+                }
+            }));
+
+    FAutoConsoleCommand CmdResetTelemetry(TEXT("StreamingManager.ResetTelemetry")
+        , TEXT("Clears the latency histograms and throughput counters")
+        , FConsoleCommandDelegate::CreateLambda([]()
+            {
+                if (UAssetStreamingSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<UAssetStreamingSubsystem>() : nullptr)
+                {
+                    Subsystem->ResetTelemetry();
+                }
+            }));
 }
 
 void UAssetStreamingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
 
+    if (StreamingCategories.Num() == 0)
+    {
+        StreamingCategories = StreamingManager::GetDefaultStreamingCategories();
+    }
+    Residency.SetCategoryCount(StreamingCategories.Num() + 1);
+    ResidencyStatNames.Reset(Residency.NumCategories());
+    for (int32 Category = 0; Category < Residency.NumCategories(); ++Category)
+    {
+        if (StreamingCategories.IsValidIndex(Category))
+        {
+            Residency.SetBudget(Category, StreamingCategories[Category].BudgetMB * 1024ll * 1024ll);
+        }
+        const FString Name = GetStreamingCategoryName(Category).ToString();
+        ResidencyStatNames.Emplace(FName(TEXT("ResidentMB_") + Name), FName(TEXT("PeakResidentMB_") + Name));
+    }
+
+    PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &UAssetStreamingSubsystem::OnPreLoadMap);
+    PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UAssetStreamingSubsystem::OnPostLoadMap);
+
     UE_LOG(LogAssetStreamingManager, Log, TEXT("[UAssetStreamingSystem] Initialized"));
 }
 
@@ -47,10 +295,49 @@ void UAssetStreamingSubsystem::Deinitialize()
 
     UE_LOG(LogAssetStreamingManager, Log, TEXT("[UAssetStreamingSystem] Deinitialize"));
 
-    RegisteredAssets.Empty();
+    FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+    SaveWarmSetCapture();
+    EndPreloadSession();
+    EndWarmSet();
+
+    Requests.Empty();
+    FreeRequestSlots.Empty();
+    BlueprintRequestIds.Empty();
+    SubmittedCommands.Empty();
+    SubmittedRequests.Empty();
+    CallbackWrappers.Empty();
+    FreeCallbackWrappers.Empty();
+    UnclaimedCallbackWrappers.Empty();
     AssetRequestCount.Empty();
     KeepAlive.Empty();
     UnloadTimers.Empty();
+    Residency.Empty();
+
+    DefaultQueue.Empty();
+    for (TArray<FAssetQueueEntry>& Queue : PriorityQueues)
+    {
+        Queue.Empty();
+    }
+    FMemory::Memzero(QueueDepths);
+    InFlightRequestCount = 0;
+    FMemory::Memzero(InFlightBytes);
+    FMemory::Memzero(InFlightRequests);
+
+    DependencyCache.Empty();
+    InFlightPrefetches.Empty();
+    PrefetchOwners.Empty();
+    PrefetchRefCounts.Empty();
+    HeldPrefetches.Empty();
+    StaleQueueEntryCount = 0;
+
+    SpatialRequests.Empty();
+    SpatialCursor = 0;
+    StreamingSources.Empty();
+    bExplicitStreamingSources = false;
+
+    PackageSizeCache.Empty();
+    Telemetry.Reset();
 }
 
 void UAssetStreamingSubsystem::Tick(float DeltaTime)
@@ -60,57 +347,58 @@ void UAssetStreamingSubsystem::Tick(float DeltaTime)
     CSV_SCOPED_TIMING_STAT_EXCLUSIVE(AssetStreamingManager);
     LLM_SCOPE_BYNAME(TEXT("AssetStreamingManager"));
 
+    DrainSubmittedCommands();
+    ReclaimUnusedCallbackWrappers();
+    UpdatePreloadReplay(DeltaTime);
+    UpdateWarmSet(DeltaTime);
+    UpdateDistancePriorities();
+
     TArray<FSoftObjectPath> ToUnload;
-    for (auto& Pair : UnloadTimers)
-    {
-        Pair.Value -= DeltaTime;
-        if (Pair.Value <= 0.f)
-        {
-            ToUnload.Add(Pair.Key);
-        }
-    }
+    UnloadTimers.Advance(DeltaTime, ToUnload);
 
     for (const FSoftObjectPath& Path : ToUnload)
     {
-        UnloadTimers.Remove(Path);
-
         if (AssetRequestCount.Contains(Path))
             continue;
 
-        KeepAlive.Remove(Path);
-
-        TArray<TSharedRef<FStreamableHandle>> Handles;
-        if (StreamableManager.GetActiveHandles(Path, Handles, true))
-        {
-            for (TSharedRef<FStreamableHandle> Handle : Handles)
-            {
-                Handle->CancelHandle();
-            }
-        }
+        UnloadAsset(Path);
+        Telemetry.RecordUnloadExpired();
     }
+    EvictOverBudgetAssets();
 
 	int32 AssetsLoaded = 0;
+    uint32 SlotIndex = 0;
+    const int32 MaxAssetsToLoad = StreamingMode == EAssetStreamingMode::Burst
+        ? StreamingManager::MaxAssetsToLoadPerTick * FMath::Max(StreamingManager::BurstLoadMultiplier, 1)
+        : StreamingManager::MaxAssetsToLoadPerTick;
 
-    // PriorityQueue
-    for (int32 Bucket = PriorityGroupCount - 1; Bucket >= 0 && AssetsLoaded < StreamingManager::MaxAssetsToLoadPerTick; --Bucket)
+    // PriorityQueue. A request over its class budget blocks the rest of its queue, lower entries are in the same or a lower class
+    for (int32 Bucket = PriorityGroupCount - 1; Bucket >= 0 && AssetsLoaded < MaxAssetsToLoad; --Bucket)
     {
-        while (PriorityQueues[PriorityGroupCount].Num() > 0 && AssetsLoaded < StreamingManager::MaxAssetsToLoadPerTick)
+        while (AssetsLoaded < MaxAssetsToLoad && PeekQueue(PriorityQueues[Bucket], SlotIndex) && HasStreamingBudget(SlotIndex))
         {
-            FAssetRequest Request = PriorityQueues[Bucket][0];
-            PriorityQueues[Bucket].RemoveAt(0);
-            StreamAsset(Request.AssetPath, Request.RequestId);
+            PopQueue(PriorityQueues[Bucket], SlotIndex);
+            StreamAsset(SlotIndex);
             ++AssetsLoaded;
         }
     }
 
     // DefaultQueue
-    while (DefaultQueue.Num() > 0 && AssetsLoaded < StreamingManager::MaxAssetsToLoadPerTick)
+    while (AssetsLoaded < MaxAssetsToLoad && PeekQueue(DefaultQueue, SlotIndex) && HasStreamingBudget(SlotIndex))
     {
-        FAssetRequest Request = DefaultQueue[0];
-        DefaultQueue.RemoveAt(0);
-        StreamAsset(Request.AssetPath, Request.RequestId);
+        PopQueue(DefaultQueue, SlotIndex);
+        StreamAsset(SlotIndex);
         ++AssetsLoaded;
     }
+
+    // Stale entries are normally dropped on pop, only compact when cancels pile up in queues that are not draining
+    const int32 PendingRequestCount = GetPendingRequestCount();
+    if (StaleQueueEntryCount > StreamingManager::MaxStaleQueueEntries && StaleQueueEntryCount > PendingRequestCount)
+    {
+        CompactQueues();
+    }
+
+    PublishTelemetry(DeltaTime);
 }
 
 TStatId UAssetStreamingSubsystem::GetStatId() const
@@ -123,67 +411,195 @@ ASSETSTREAMINGMANAGER_API int32 UAssetStreamingSubsystem::GetPriorityGroup(const
     return FMath::Clamp(Priority / 10, 0, PriorityGroupCount - 1);
 }
 
-bool UAssetStreamingSubsystem::RequestAssetStreaming(const FSoftObjectPath& AssetPath, FGuid& OutRequestId, const int32& Priority)
+EAssetStreamingPriorityClass UAssetStreamingSubsystem::GetPriorityClass(const int32 Priority) const
 {
-    OutRequestId = FGuid::NewGuid();
-    FAssetRequest Request(AssetPath, OutRequestId, Priority);
-
     if (Priority == 0)
     {
-        // Default queue
-        DefaultQueue.Add(Request);
+        return EAssetStreamingPriorityClass::Background;
     }
-    else
+    return Priority >= StreamingManager::CriticalPriority ? EAssetStreamingPriorityClass::Critical : EAssetStreamingPriorityClass::Normal;
+}
+
+void UAssetStreamingSubsystem::SetStreamingMode(EAssetStreamingMode Mode)
+{
+    if (StreamingMode != Mode)
     {
-		int32 PriorityGroup = GetPriorityGroup(Priority);
-        // Priority queue
-        if (PriorityQueues[PriorityGroup].Num() >= MaxPriorityQueueSize)
-        {
-            // sort, if queue is full, remove the lowest priority
-            PriorityQueues[PriorityGroup].RemoveAt(PriorityQueues[PriorityGroup].Num() - 1);
-        }
-        PriorityQueues[PriorityGroup].Add(Request);
+        UE_LOG(LogAssetStreamingManager, Log, TEXT("Streaming mode %s -> %s"), *UEnum::GetValueAsString(StreamingMode), *UEnum::GetValueAsString(Mode));
+        StreamingMode = Mode;
+    }
+}
+
+void UAssetStreamingSubsystem::SetStreamingBudget(EAssetStreamingMode Mode, EAssetStreamingPriorityClass PriorityClass, const FAssetStreamingBudget& Budget)
+{
+    StreamingBudgets[static_cast<int32>(Mode)][static_cast<int32>(PriorityClass)] = Budget;
+}
+
+const FAssetStreamingBudget& UAssetStreamingSubsystem::GetStreamingBudget(EAssetStreamingMode Mode, EAssetStreamingPriorityClass PriorityClass) const
+{
+    return StreamingBudgets[static_cast<int32>(Mode)][static_cast<int32>(PriorityClass)];
+}
+
+TAsyncLoadPriority UAssetStreamingSubsystem::GetAsyncLoadPriority(const int32 Priority) const
+{
+    if (Priority <= 0)
+    {
+        return StreamingManager::AsyncLoadPriorityMin;
+    }
+
+    // Same range as the priority groups, Priority >= (PriorityGroupCount - 1) * 10 maps to Max
+    const float Alpha = FMath::Clamp(static_cast<float>(Priority) / ((PriorityGroupCount - 1) * 10), 0.f, 1.f);
+    const float Curved = FMath::Pow(Alpha, FMath::Max(StreamingManager::AsyncLoadPriorityExponent, UE_KINDA_SMALL_NUMBER));
+    return FMath::RoundToInt(FMath::Lerp(static_cast<float>(StreamingManager::AsyncLoadPriorityMin), static_cast<float>(StreamingManager::AsyncLoadPriorityMax), Curved));
+}
+
+bool UAssetStreamingSubsystem::RequestAssetStreaming(const FSoftObjectPath& AssetPath, FAssetRequestHandle& OutRequestHandle, const int32& Priority)
+{
+    OutRequestHandle = AllocateRequest(AssetPath, Priority);
+
+    if (!EnqueueRequest(OutRequestHandle.Index))
+    {
+        // Dropped because its priority queue is full of higher priority requests
+        OutRequestHandle.Invalidate();
     }
 
-    return OutRequestId.IsValid();
+    return OutRequestHandle.IsValid();
 }
 
-bool UAssetStreamingSubsystem::RequestAssetsStreaming(const TArray<FSoftObjectPath>& AssetPaths, TArray<FGuid>& OutRequestId, const int32& Priority)
+bool UAssetStreamingSubsystem::RequestAssetsStreaming(const TArray<FSoftObjectPath>& AssetPaths, TArray<FAssetRequestHandle>& OutRequestHandles, const int32& Priority)
 {
     if (AssetPaths.Num() == 0)
     {
-        OutRequestId.Empty();
+        OutRequestHandles.Empty();
         return false;
     }
 
+    bool bAllQueued = true;
+    OutRequestHandles.Reserve(OutRequestHandles.Num() + AssetPaths.Num());
     for (const FSoftObjectPath& AssetPath : AssetPaths)
     {
-		FGuid RequestId = FGuid::NewGuid();
-		OutRequestId.Add(RequestId);
-
-		FAssetRequest Request(AssetPath, RequestId, Priority);
-
-        if(Priority == 0)
-        {
-            // Default queue
-            DefaultQueue.Add(Request);
-        }
-        else
+		FAssetRequestHandle RequestHandle = AllocateRequest(AssetPath, Priority);
+        if (!EnqueueRequest(RequestHandle.Index))
         {
-            int32 PriorityGroup = GetPriorityGroup(Priority);
-            // Priority queue
-            if (PriorityQueues[PriorityGroup].Num() >= MaxPriorityQueueSize)
-            {
-                // sort, if queue is full, remove the lowest priority
-                PriorityQueues[PriorityGroup].RemoveAt(PriorityQueues[PriorityGroup].Num() - 1);
-            }
-            PriorityQueues[PriorityGroup].Add(Request);
+            // Dropped because its priority queue is full of higher priority requests, the handle stays in place but invalid
+            RequestHandle.Invalidate();
+            bAllQueued = false;
         }
+		OutRequestHandles.Add(RequestHandle);
+    }
+
+    return bAllQueued;
+}
+
+bool UAssetStreamingSubsystem::RequestAssetStreamingWithCallback(const FSoftObjectPath& AssetPath, FAssetRequestHandle& OutRequestHandle, const TScriptInterface<IAssetStreamingCallback>& Callback, const int32& Priority)
+{
+    if (!RequestAssetStreaming(AssetPath, OutRequestHandle, Priority))
+    {
+        return false;
+    }
+    SetRequestCallback(OutRequestHandle, Callback);
+    return true;
+}
+
+bool UAssetStreamingSubsystem::RequestAssetsStreamingWithCallback(const TArray<FSoftObjectPath>& AssetPaths, TArray<FAssetRequestHandle>& OutRequestHandles, const TScriptInterface<IAssetStreamingCallback>& Callback, const int32& Priority)
+{
+    const int32 FirstIndex = OutRequestHandles.Num();
+    const bool bAllQueued = RequestAssetsStreaming(AssetPaths, OutRequestHandles, Priority);
+    for (int32 Index = FirstIndex; Index < OutRequestHandles.Num(); ++Index)
+    {
+        // Dropped requests have an invalid handle and are skipped
+        SetRequestCallback(OutRequestHandles[Index], Callback);
+    }
+    return bAllQueued;
+}
+
+bool UAssetStreamingSubsystem::RequestAssetStreamingWithCallback(const FSoftObjectPath& AssetPath, FAssetRequestHandle& OutRequestHandle, FOnAssetRequestCompleted OnCompleted, const int32& Priority)
+{
+    if (!RequestAssetStreaming(AssetPath, OutRequestHandle, Priority))
+    {
+        return false;
     }
+    Requests[OutRequestHandle.Index].OnCompleted = MoveTemp(OnCompleted);
+    return true;
+}
+
+bool UAssetStreamingSubsystem::RequestAssetStreamingAtLocation(const FSoftObjectPath& AssetPath, FAssetRequestHandle& OutRequestHandle, const FVector& Location, const int32& Priority, const bool bIgnoreZ)
+{
+    // Start at the effective priority so the request lands in the right queue right away
+    FAssetRequest Probe;
+    Probe.Location = Location;
+    Probe.bIgnoreZ = bIgnoreZ;
+    const int32 EffectivePriority = StreamingSources.Num() > 0 ? GetDistancePriority(Priority, GetNearestSourceDistance(Probe)) : Priority;
 
+    if (!RequestAssetStreaming(AssetPath, OutRequestHandle, EffectivePriority))
+    {
+        return false;
+    }
+    TrackSpatialRequest(OutRequestHandle.Index, Location, Priority, bIgnoreZ);
     return true;
 }
 
+bool UAssetStreamingSubsystem::RequestAssetStreamingAtCell(const FSoftObjectPath& AssetPath, FAssetRequestHandle& OutRequestHandle, const FInt64Vector& Cell, const int32 CellSize, const int32& Priority, const bool b2DGrid)
+{
+    const FVector CellCenter = (FVector(Cell.X, Cell.Y, Cell.Z) + FVector(0.5)) * FMath::Max(CellSize, 1);
+    return RequestAssetStreamingAtLocation(AssetPath, OutRequestHandle, CellCenter, Priority, b2DGrid);
+}
+
+void UAssetStreamingSubsystem::SetStreamingSources(const TArray<FVector>& Sources)
+{
+    StreamingSources = Sources;
+    bExplicitStreamingSources = true;
+}
+
+void UAssetStreamingSubsystem::ClearStreamingSources()
+{
+    StreamingSources.Reset();
+    bExplicitStreamingSources = false;
+}
+
+int32 UAssetStreamingSubsystem::GetDistancePriority(const int32 BasePriority, const double Distance) const
+{
+    if (BasePriority <= 0 || StreamingManager::DistancePriorityFalloff <= 0.f)
+    {
+        return BasePriority;
+    }
+
+    const double Alpha = FMath::Clamp(Distance / StreamingManager::DistancePriorityFalloff, 0.0, 1.0);
+    return FMath::RoundToInt32(BasePriority * (1.0 - Alpha));
+}
+
+UAssetStreamingCallbackWrapper* UAssetStreamingSubsystem::AcquireCallbackWrapper()
+{
+    UAssetStreamingCallbackWrapper* Wrapper = nullptr;
+    if (FreeCallbackWrappers.Num() > 0)
+    {
+        Wrapper = CallbackWrappers[FreeCallbackWrappers.Pop(EAllowShrinking::No)];
+        Wrapper->bInFreeList = false;
+    }
+    else
+    {
+        Wrapper = NewObject<UAssetStreamingCallbackWrapper>(this);
+        Wrapper->PoolIndex = CallbackWrappers.Add(Wrapper);
+    }
+    UnclaimedCallbackWrappers.Add(Wrapper->PoolIndex);
+    return Wrapper;
+}
+
+void UAssetStreamingSubsystem::ReclaimUnusedCallbackWrappers()
+{
+    for (const int32 PoolIndex : UnclaimedCallbackWrappers)
+    {
+        UAssetStreamingCallbackWrapper* Wrapper = CallbackWrappers.IsValidIndex(PoolIndex) ? CallbackWrappers[PoolIndex].Get() : nullptr;
+        // Already back in the pool when its request completed within the frame
+        if (Wrapper && Wrapper->UseCount == 0 && !Wrapper->bInFreeList)
+        {
+            Wrapper->ResetCallback();
+            Wrapper->bInFreeList = true;
+            FreeCallbackWrappers.Add(PoolIndex);
+        }
+    }
+    UnclaimedCallbackWrappers.Reset();
+}
+
 ASSETSTREAMINGMANAGER_API UObject* UAssetStreamingSubsystem::LoadAssetSync(const FSoftObjectPath& AssetPath)
 {
     if (AssetPath.IsNull())
@@ -192,9 +608,25 @@ ASSETSTREAMINGMANAGER_API UObject* UAssetStreamingSubsystem::LoadAssetSync(const
         return nullptr;
     }
 
+    if (UObject* LoadedAsset = AssetPath.ResolveObject())
+    {
+        return LoadedAsset;
+    }
+
     if (IsAsyncLoading())
     {
-        UE_LOG(LogAssetStreamingManager, Warning, TEXT("LoadAssetSync: Attempted sync load during async loading phase."));
+        // TryLoad would flush every package in flight, escalate this one and wait for it alone first
+        FAssetRequestHandle RequestHandle;
+        TFuture<UObject*> Future = LoadAssetUrgent(AssetPath, RequestHandle, StreamingManager::SyncLoadTimeoutSeconds);
+        UObject* LoadedAsset = Future.IsReady() ? Future.Get() : nullptr;
+        ReleaseAsset(RequestHandle);
+        if (LoadedAsset)
+        {
+            return LoadedAsset;
+        }
+
+        UE_LOG(LogAssetStreamingManager, Warning, TEXT("LoadAssetSync: '%s' not loaded after %.2fs of escalation, falling back to a blocking load during async loading."),
+            *AssetPath.ToString(), StreamingManager::SyncLoadTimeoutSeconds);
     }
 
     UObject* LoadedAsset = AssetPath.TryLoad();
@@ -207,15 +639,75 @@ ASSETSTREAMINGMANAGER_API UObject* UAssetStreamingSubsystem::LoadAssetSync(const
     return LoadedAsset;
 }
 
-bool UAssetStreamingSubsystem::ReleaseAsset(FGuid& RequestId)
+TFuture<UObject*> UAssetStreamingSubsystem::LoadAssetUrgent(const FSoftObjectPath& AssetPath, FAssetRequestHandle& OutRequestHandle, const float TimeoutSeconds)
+{
+    OutRequestHandle.Invalidate();
+    if (AssetPath.IsNull())
+    {
+        return MakeFulfilledPromise<UObject*>(nullptr).GetFuture();
+    }
+
+    // Queued requests for the same asset complete right after this one, as long as the top queue has room for them.
+    // Rare path, a scan is cheaper than keeping a path index up to date for every request.
+    const int32 UrgentQueueIndex = GetQueueIndex(UrgentPriority);
+    for (int32 SlotIndex = 0; SlotIndex < Requests.Num() && QueueDepths[UrgentQueueIndex] < MaxPriorityQueueSize; ++SlotIndex)
+    {
+        FAssetRequest& Request = Requests[SlotIndex];
+        if (Request.State == EAssetRequestState::Pending && Request.AssetPath == AssetPath)
+        {
+            UntrackSpatialRequest(Request);
+            UpdateRequestPriority(FAssetRequestHandle(SlotIndex, Request.Generation), UrgentPriority);
+        }
+    }
+
+    // Issued right away, bypassing the queues and the governor. Re-requesting a package that is already in flight raises its priority
+    OutRequestHandle = AllocateRequest(AssetPath, UrgentPriority);
+    TSharedPtr<TPromise<UObject*>> Promise = MakeShared<TPromise<UObject*>>();
+    TFuture<UObject*> Future = Promise->GetFuture();
+    Requests[OutRequestHandle.Index].UrgentPromise = Promise;
+    StreamAsset(OutRequestHandle.Index);
+
+    FAssetRequest* Request = ResolveRequest(OutRequestHandle);
+    if (!Request || !Request->UrgentPromise.IsValid())
+    {
+        // Completed or failed synchronously
+        return Future;
+    }
+
+    const TSharedPtr<FStreamableHandle> Handle = Request->Handle;
+    if (TimeoutSeconds > 0.f && Handle.IsValid() && Handle->IsLoadingInProgress())
+    {
+        // Flushes only the packages of this handle
+        Handle->WaitUntilComplete(TimeoutSeconds);
+    }
+
+    Request = ResolveRequest(OutRequestHandle);
+    if (Request && Request->UrgentPromise.IsValid() && Handle.IsValid() && Handle->HasLoadCompleted())
+    {
+        // The streamable delegate may be deferred to a later frame, do not make the caller wait for it
+        Request->UrgentPromise->SetValue(AssetPath.ResolveObject());
+        Request->UrgentPromise.Reset();
+    }
+    return Future;
+}
+
+bool UAssetStreamingSubsystem::ReleaseAsset(FAssetRequestHandle& RequestHandle)
 {
-    if (!RequestId.IsValid() || !RegisteredAssets.Contains(RequestId))
+    FAssetRequest* Request = ResolveRequest(RequestHandle);
+    if (!Request)
     {
-        RequestId.Invalidate();
+        RequestHandle.Invalidate();
         return false;
     }
-    const FSoftObjectPath Path = RegisteredAssets[RequestId].Asset;
-    const TSharedPtr<FStreamableHandle> Handle = RegisteredAssets[RequestId].Handle;
+
+    if (Request->State == EAssetRequestState::Pending)
+    {
+        // Never reached StreamAsset, nothing to unload
+        return CancelRequest(RequestHandle);
+    }
+
+    const FSoftObjectPath Path = Request->AssetPath;
+    const TSharedPtr<FStreamableHandle> Handle = Request->Handle;
 
     if (!AssetRequestCount.Contains(Path))
     {
@@ -235,92 +727,1579 @@ bool UAssetStreamingSubsystem::ReleaseAsset(FGuid& RequestId)
         Handle->CancelHandle();
     }
 
-    RegisteredAssets.Remove(RequestId);
+    FreeRequest(RequestHandle.Index);
 
-    if (!UnloadTimers.Contains(Path))
+    if (!AssetRequestCount.Contains(Path))
     {
-        UnloadTimers.Add(Path, StreamingManager::CVarUnloadDelaySeconds->GetFloat());
+        // Delay counts from the last release, a re-request cancels it in StreamAsset
+        UnloadTimers.Schedule(Path, StreamingManager::UnloadDelaySeconds);
+        Residency.MarkReleased(Path);
     }
 
-    RequestId.Invalidate();
+    RequestHandle.Invalidate();
     return true;
 }
 
-bool UAssetStreamingSubsystem::ReleaseAssets(const TArray<FGuid>& RequestIds)
+bool UAssetStreamingSubsystem::ReleaseAssets(const TArray<FAssetRequestHandle>& RequestHandles)
 {
     bool bAllReleased = true;
-    for (FGuid RequestId : RequestIds)
+    for (FAssetRequestHandle RequestHandle : RequestHandles)
     {
-        bAllReleased &= ReleaseAsset(RequestId);
+        bAllReleased &= ReleaseAsset(RequestHandle);
     }
     return bAllReleased;
 }
 
-bool UAssetStreamingSubsystem::K2_RequestAssetsStreaming(const TArray<FSoftObjectPath>& AssetsToStream, TArray<FGuid>& OutAssetRequestId)
+bool UAssetStreamingSubsystem::UpdateRequestPriority(const FAssetRequestHandle& RequestHandle, int32 NewPriority)
 {
-    return RequestAssetsStreaming(AssetsToStream, OutAssetRequestId);
+    FAssetRequest* Request = ResolveRequest(RequestHandle);
+    if (!Request)
+    {
+        return false;
+    }
+
+    if (Request->Priority == NewPriority)
+    {
+        return true;
+    }
+
+    if (Request->State == EAssetRequestState::Streaming)
+    {
+        Request->Priority = NewPriority;
+        EscalateInFlightRequest(RequestHandle.Index);
+        return true;
+    }
+
+    // A full group rejects the move, the request stays queued at its old priority and nobody is evicted
+    const int32 NewQueueIndex = GetQueueIndex(NewPriority);
+    if (NewQueueIndex != 0 && NewQueueIndex != GetQueueIndex(Request->Priority) && QueueDepths[NewQueueIndex] >= MaxPriorityQueueSize)
+    {
+        return false;
+    }
+
+    // The old heap entry is left behind as stale, pushing a new one keeps this O(log n)
+    ++StaleQueueEntryCount;
+    --QueueDepths[GetQueueIndex(Request->Priority)];
+    Request->Priority = NewPriority;
+
+    return EnqueueRequest(RequestHandle.Index);
 }
 
-bool UAssetStreamingSubsystem::K2_RequestAssetsStreamingWithCallback(const TArray<FSoftObjectPath>& AssetsToStream, TArray<FGuid>& OutAssetRequestId)
+bool UAssetStreamingSubsystem::CancelRequest(FAssetRequestHandle& RequestHandle)
 {
-    return RequestAssetsStreaming(AssetsToStream, OutAssetRequestId);
+    const FAssetRequest* Request = ResolveRequest(RequestHandle);
+    if (!Request || Request->State != EAssetRequestState::Pending)
+    {
+        return false;
+    }
+
+    ++StaleQueueEntryCount;
+    --QueueDepths[GetQueueIndex(Request->Priority)];
+    FreeRequest(RequestHandle.Index);
+    RequestHandle.Invalidate();
+    return true;
 }
 
-bool UAssetStreamingSubsystem::K2_RequestAssetStreaming(const FSoftObjectPath& AssetToStream, FGuid& OutAssetRequestId)
+bool UAssetStreamingSubsystem::IsRequestPending(const FAssetRequestHandle& RequestHandle) const
 {
-    return RequestAssetStreaming(AssetToStream, OutAssetRequestId);
+    const FAssetRequest* Request = ResolveRequest(RequestHandle);
+    return Request && Request->State == EAssetRequestState::Pending;
 }
 
-bool UAssetStreamingSubsystem::K2_RequestAssetStreamingWithCallback(const FSoftObjectPath& AssetToStream, FGuid& OutAssetRequestId)
+int32 UAssetStreamingSubsystem::GetRequestPriority(const FAssetRequestHandle& RequestHandle) const
 {
-    return RequestAssetStreaming(AssetToStream, OutAssetRequestId);
+    const FAssetRequest* Request = ResolveRequest(RequestHandle);
+    return Request ? Request->Priority : INDEX_NONE;
 }
 
-bool UAssetStreamingSubsystem::K2_ReleaseAssets(UPARAM(Ref) FGuid& RequestId)
+FAssetRequestTicket UAssetStreamingSubsystem::SubmitRequest(const FSoftObjectPath& AssetPath, const int32 Priority,
+    FOnAssetRequestCompleted OnCompleted, ENamedThreads::Type CompletionThread)
 {
-    return ReleaseAsset(RequestId);
+    FAssetStreamingCommand Command;
+    Command.Type = EAssetStreamingCommandType::Request;
+    Command.Ticket = NextSubmissionTicket.fetch_add(1, std::memory_order_relaxed);
+    Command.AssetPath = AssetPath;
+    Command.Priority = Priority;
+    Command.OnCompleted = MoveTemp(OnCompleted);
+    Command.CompletionThread = CompletionThread;
+
+    const FAssetRequestTicket Ticket = Command.Ticket;
+    SubmittedCommands.Enqueue(MoveTemp(Command));
+    return Ticket;
 }
 
-void UAssetStreamingSubsystem::StreamAsset(const FSoftObjectPath& AssetPath, const FGuid& RequestId)
+void UAssetStreamingSubsystem::SubmitRelease(const FAssetRequestTicket Ticket)
 {
-    if (AssetPath.IsNull()) return;
+    FAssetStreamingCommand Command;
+    Command.Type = EAssetStreamingCommandType::Release;
+    Command.Ticket = Ticket;
+    SubmittedCommands.Enqueue(MoveTemp(Command));
+}
 
-    const bool bIsAssetLoaded = StreamableManager.IsAsyncLoadComplete(AssetPath);
-    FStreamableDelegate OnLoaded;
-    OnLoaded.BindLambda([WeakThis = MakeWeakObjectPtr(this), AssetPath, bIsAssetLoaded]()
+void UAssetStreamingSubsystem::DrainSubmittedCommands()
+{
+    FAssetStreamingCommand Command;
+    while (SubmittedCommands.Dequeue(Command))
+    {
+        if (Command.Type == EAssetStreamingCommandType::Request)
         {
-            if (WeakThis.IsValid())
+            FAssetRequestHandle RequestHandle;
+            if (!RequestAssetStreaming(Command.AssetPath, RequestHandle, Command.Priority))
             {
-                WeakThis->HandleAssetLoaded(AssetPath, bIsAssetLoaded);
+                continue;
             }
-        });
-
-    TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
-        AssetPath, OnLoaded, FStreamableManager::DefaultAsyncLoadPriority, true);
 
-    RegisteredAssets.FindOrAdd(RequestId);
-    RegisteredAssets[RequestId] = FAssetHandleStruct(AssetPath, Handle);
-
-    if (!KeepAlive.Contains(AssetPath))
-    {
-        KeepAlive.Add(AssetPath, Handle);
+            FAssetRequest& Request = Requests[RequestHandle.Index];
+            Request.OnCompleted = MoveTemp(Command.OnCompleted);
+            Request.CompletionThread = Command.CompletionThread;
+            SubmittedRequests.Add(Command.Ticket, RequestHandle);
+        }
+        else
+        {
+            FAssetRequestHandle RequestHandle;
+            if (SubmittedRequests.RemoveAndCopyValue(Command.Ticket, RequestHandle))
+            {
+                ReleaseAsset(RequestHandle);
+            }
+            else
+            {
+                UE_LOG(LogAssetStreamingManager, Verbose, TEXT("SubmitRelease: Unknown or dropped ticket %llu."), Command.Ticket);
+            }
+        }
     }
+}
+
+bool UAssetStreamingSubsystem::K2_RequestAssetsStreaming(const TArray<FSoftObjectPath>& AssetsToStream, TArray<FGuid>& OutAssetRequestId)
+{
+    TArray<FAssetRequestHandle> RequestHandles;
+    const bool bRequested = RequestAssetsStreaming(AssetsToStream, RequestHandles);
+    for (const FAssetRequestHandle& RequestHandle : RequestHandles)
+    {
+        OutAssetRequestId.Add(MakeBlueprintId(RequestHandle));
+    }
+    return bRequested;
+}
+
+bool UAssetStreamingSubsystem::K2_RequestAssetsStreamingWithCallback(const TArray<FSoftObjectPath>& AssetsToStream, TScriptInterface<IAssetStreamingCallback> Callback, TArray<FGuid>& OutAssetRequestId)
+{
+    TArray<FAssetRequestHandle> RequestHandles;
+    const bool bRequested = RequestAssetsStreamingWithCallback(AssetsToStream, RequestHandles, Callback);
+    for (const FAssetRequestHandle& RequestHandle : RequestHandles)
+    {
+        OutAssetRequestId.Add(MakeBlueprintId(RequestHandle));
+    }
+    return bRequested;
+}
+
+bool UAssetStreamingSubsystem::K2_RequestAssetStreaming(const FSoftObjectPath& AssetToStream, FGuid& OutAssetRequestId)
+{
+    FAssetRequestHandle RequestHandle;
+    const bool bRequested = RequestAssetStreaming(AssetToStream, RequestHandle);
+    OutAssetRequestId = MakeBlueprintId(RequestHandle);
+    return bRequested;
+}
+
+bool UAssetStreamingSubsystem::K2_RequestAssetStreamingWithCallback(const FSoftObjectPath& AssetToStream, TScriptInterface<IAssetStreamingCallback> Callback, FGuid& OutAssetRequestId)
+{
+    FAssetRequestHandle RequestHandle;
+    const bool bRequested = RequestAssetStreamingWithCallback(AssetToStream, RequestHandle, Callback);
+    OutAssetRequestId = MakeBlueprintId(RequestHandle);
+    return bRequested;
+}
+
+void UAssetStreamingSubsystem::TrackSpatialRequest(const uint32 SlotIndex, const FVector& Location, const int32 BasePriority, const bool bIgnoreZ)
+{
+    FAssetRequest& Request = Requests[SlotIndex];
+    Request.Location = Location;
+    Request.BasePriority = BasePriority;
+    Request.bIgnoreZ = bIgnoreZ;
+    if (Request.SpatialIndex == INDEX_NONE)
+    {
+        Request.SpatialIndex = SpatialRequests.Add(SlotIndex);
+    }
+}
+
+void UAssetStreamingSubsystem::UntrackSpatialRequest(FAssetRequest& Request)
+{
+    const int32 SpatialIndex = Request.SpatialIndex;
+    if (SpatialIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    SpatialRequests.RemoveAtSwap(SpatialIndex, EAllowShrinking::No);
+    if (SpatialRequests.IsValidIndex(SpatialIndex))
+    {
+        Requests[SpatialRequests[SpatialIndex]].SpatialIndex = SpatialIndex;
+    }
+    Request.SpatialIndex = INDEX_NONE;
+}
+
+double UAssetStreamingSubsystem::GetNearestSourceDistance(const FAssetRequest& Request) const
+{
+    double NearestSquared = TNumericLimits<double>::Max();
+    for (const FVector& Source : StreamingSources)
+    {
+        NearestSquared = FMath::Min(NearestSquared, Request.bIgnoreZ ? FVector::DistSquared2D(Source, Request.Location) : FVector::DistSquared(Source, Request.Location));
+    }
+    return FMath::Sqrt(NearestSquared);
+}
+
+void UAssetStreamingSubsystem::GatherStreamingSources()
+{
+    StreamingSources.Reset();
+    if (!GEngine)
+    {
+        return;
+    }
+
+    for (const FWorldContext& Context : GEngine->GetWorldContexts())
+    {
+        const UWorld* World = Context.World();
+        if (!World || !World->IsGameWorld())
+        {
+            continue;
+        }
+
+        for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+        {
+            const APlayerController* PlayerController = Iterator->Get();
+            if (PlayerController && PlayerController->IsLocalController())
+            {
+                FVector ViewLocation;
+                FRotator ViewRotation;
+                PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+                StreamingSources.Add(ViewLocation);
+            }
+        }
+    }
+}
+
+void UAssetStreamingSubsystem::UpdateDistancePriorities()
+{
+    if (SpatialRequests.Num() == 0)
+    {
+        return;
+    }
+
+    if (!bExplicitStreamingSources)
+    {
+        GatherStreamingSources();
+    }
+    if (StreamingSources.Num() == 0)
+    {
+        return;
+    }
+
+    // Round-robin over the spatial requests, so a full pass costs SpatialRequests.Num() / DistancePriorityUpdatesPerTick ticks
+    const int32 UpdateCount = FMath::Min(StreamingManager::DistancePriorityUpdatesPerTick, SpatialRequests.Num());
+    for (int32 Step = 0; Step < UpdateCount && SpatialRequests.Num() > 0; ++Step)
+    {
+        if (SpatialCursor >= SpatialRequests.Num())
+        {
+            SpatialCursor = 0;
+        }
+        const uint32 SlotIndex = SpatialRequests[SpatialCursor++];
+        const FAssetRequest& Request = Requests[SlotIndex];
+
+        const int32 NewPriority = GetDistancePriority(Request.BasePriority, GetNearestSourceDistance(Request));
+        if (NewPriority == Request.Priority)
+        {
+            continue;
+        }
+
+        // Re-issuing an in-flight load is not free, only escalate when it moves up a priority group
+        const int32 NewQueueIndex = GetQueueIndex(NewPriority);
+        if (Request.State == EAssetRequestState::Streaming && NewQueueIndex <= GetQueueIndex(Request.Priority))
+        {
+            continue;
+        }
+
+        // A full group rejects the move, it is retried on the next pass
+        UpdateRequestPriority(FAssetRequestHandle(SlotIndex, Request.Generation), NewPriority);
+    }
+}
+
+void UAssetStreamingSubsystem::SetRequestCallback(const FAssetRequestHandle& RequestHandle, const TScriptInterface<IAssetStreamingCallback>& Callback)
+{
+    FAssetRequest* Request = ResolveRequest(RequestHandle);
+    UObject* CallbackObject = Callback.GetObject();
+    if (!Request || !CallbackObject || !CallbackObject->GetClass()->ImplementsInterface(UAssetStreamingCallback::StaticClass()))
+    {
+        return;
+    }
+    ReleaseRequestCallback(*Request);
+    Request->CallbackObject = CallbackObject;
+
+    if (UAssetStreamingCallbackWrapper* Wrapper = Cast<UAssetStreamingCallbackWrapper>(CallbackObject))
+    {
+        ++Wrapper->UseCount;
+    }
+}
+
+void UAssetStreamingSubsystem::ReleaseRequestCallback(FAssetRequest& Request)
+{
+    UObject* CallbackObject = Request.CallbackObject.Get();
+    Request.CallbackObject.Reset();
+    ReleaseCallbackWrapper(CallbackObject);
+}
+
+void UAssetStreamingSubsystem::ReleaseCallbackWrapper(UObject* CallbackObject)
+{
+    UAssetStreamingCallbackWrapper* Wrapper = Cast<UAssetStreamingCallbackWrapper>(CallbackObject);
+    if (!Wrapper || --Wrapper->UseCount > 0)
+    {
+        return;
+    }
+
+    Wrapper->UseCount = 0;
+    if (!Wrapper->bInFreeList && CallbackWrappers.IsValidIndex(Wrapper->PoolIndex) && CallbackWrappers[Wrapper->PoolIndex] == Wrapper)
+    {
+        Wrapper->ResetCallback();
+        Wrapper->bInFreeList = true;
+        FreeCallbackWrappers.Add(Wrapper->PoolIndex);
+    }
+}
+
+bool UAssetStreamingSubsystem::K2_RequestAssetStreamingAtLocation(const FSoftObjectPath& AssetToStream, const FVector& Location, int32 Priority, FGuid& OutAssetRequestId)
+{
+    FAssetRequestHandle RequestHandle;
+    const bool bRequested = RequestAssetStreamingAtLocation(AssetToStream, RequestHandle, Location, Priority);
+    OutAssetRequestId = MakeBlueprintId(RequestHandle);
+    return bRequested;
+}
+
+bool UAssetStreamingSubsystem::K2_ReleaseAssets(UPARAM(Ref) FGuid& RequestId)
+{
+    FAssetRequestHandle RequestHandle;
+    ResolveBlueprintId(RequestId, RequestHandle);
+    RequestId.Invalidate();
+    return ReleaseAsset(RequestHandle);
+}
+
+bool UAssetStreamingSubsystem::K2_UpdateRequestPriority(const FGuid& RequestId, int32 NewPriority)
+{
+    FAssetRequestHandle RequestHandle;
+    return ResolveBlueprintId(RequestId, RequestHandle) && UpdateRequestPriority(RequestHandle, NewPriority);
+}
+
+bool UAssetStreamingSubsystem::K2_CancelRequest(UPARAM(Ref) FGuid& RequestId)
+{
+    FAssetRequestHandle RequestHandle;
+    if (!ResolveBlueprintId(RequestId, RequestHandle) || !CancelRequest(RequestHandle))
+    {
+        return false;
+    }
+    RequestId.Invalidate();
+    return true;
+}
+
+FAssetRequest* UAssetStreamingSubsystem::ResolveRequest(const FAssetRequestHandle& RequestHandle)
+{
+    if (!RequestHandle.IsValid() || !Requests.IsValidIndex(RequestHandle.Index))
+    {
+        return nullptr;
+    }
+    FAssetRequest& Request = Requests[RequestHandle.Index];
+    return Request.Generation == RequestHandle.Generation && Request.State != EAssetRequestState::Free ? &Request : nullptr;
+}
+
+const FAssetRequest* UAssetStreamingSubsystem::ResolveRequest(const FAssetRequestHandle& RequestHandle) const
+{
+    return const_cast<UAssetStreamingSubsystem*>(this)->ResolveRequest(RequestHandle);
+}
+
+FAssetRequestHandle UAssetStreamingSubsystem::AllocateRequest(const FSoftObjectPath& AssetPath, const int32 Priority)
+{
+    const uint32 SlotIndex = FreeRequestSlots.Num() > 0 ? FreeRequestSlots.Pop(EAllowShrinking::No) : Requests.AddDefaulted();
+
+    FAssetRequest& Request = Requests[SlotIndex];
+    Request.AssetPath = AssetPath;
+    Request.Priority = Priority;
+    Request.State = EAssetRequestState::Pending;
+    Request.RequestTime = FPlatformTime::Seconds();
+    RecordPreloadRequest(AssetPath);
+
+    return FAssetRequestHandle(SlotIndex, Request.Generation);
+}
+
+void UAssetStreamingSubsystem::FreeRequest(const uint32 SlotIndex)
+{
+    FAssetRequest& Request = Requests[SlotIndex];
+    if (Request.BlueprintId.IsValid())
+    {
+        BlueprintRequestIds.Remove(Request.BlueprintId);
+        Request.BlueprintId.Invalidate();
+    }
+
+    Request.AssetPath.Reset();
+    Request.Handle.Reset();
+    Request.OnCompleted.Unbind();
+    Request.CompletionThread = ENamedThreads::GameThread;
+    ReleaseRequestCallback(Request);
+    EndInFlight(Request);
+    UntrackSpatialRequest(Request);
+    if (Request.UrgentPromise.IsValid())
+    {
+        Request.UrgentPromise->SetValue(nullptr);
+        Request.UrgentPromise.Reset();
+    }
+    Request.RequestTime = 0.0;
+    Request.EstimatedBytes = 0;
+    Request.State = EAssetRequestState::Free;
+    // Generation 0 is reserved for invalid handles
+    Request.Generation = FMath::Max<uint32>(Request.Generation + 1, 1);
+
+    FreeRequestSlots.Add(SlotIndex);
+}
+
+bool UAssetStreamingSubsystem::ResolveBlueprintId(const FGuid& RequestId, FAssetRequestHandle& OutRequestHandle) const
+{
+    const FAssetRequestHandle* Found = BlueprintRequestIds.Find(RequestId);
+    OutRequestHandle = Found ? *Found : FAssetRequestHandle();
+    return Found != nullptr;
+}
+
+FGuid UAssetStreamingSubsystem::MakeBlueprintId(const FAssetRequestHandle& RequestHandle)
+{
+    FAssetRequest* Request = ResolveRequest(RequestHandle);
+    if (!Request)
+    {
+        return FGuid();
+    }
+
+    Request->BlueprintId = FGuid::NewGuid();
+    BlueprintRequestIds.Add(Request->BlueprintId, RequestHandle);
+    return Request->BlueprintId;
+}
+
+TArray<FAssetQueueEntry>& UAssetStreamingSubsystem::GetQueue(const int32 Priority)
+{
+    return Priority == 0 ? DefaultQueue : PriorityQueues[GetPriorityGroup(Priority)];
+}
+
+int32 UAssetStreamingSubsystem::GetQueueIndex(const int32 Priority)
+{
+    return Priority == 0 ? 0 : 1 + GetPriorityGroup(Priority);
+}
+
+SIZE_T UAssetStreamingSubsystem::GetAllocatedSize() const
+{
+    SIZE_T Size = Requests.GetAllocatedSize() + FreeRequestSlots.GetAllocatedSize() + BlueprintRequestIds.GetAllocatedSize()
+        + SubmittedRequests.GetAllocatedSize() + AssetRequestCount.GetAllocatedSize() + KeepAlive.GetAllocatedSize()
+        + UnloadTimers.GetAllocatedSize() + DefaultQueue.GetAllocatedSize() + DependencyCache.GetAllocatedSize()
+        + InFlightPrefetches.GetAllocatedSize() + PrefetchOwners.GetAllocatedSize() + PrefetchRefCounts.GetAllocatedSize() + HeldPrefetches.GetAllocatedSize() + PackageSizeCache.GetAllocatedSize() + CallbackWrappers.GetAllocatedSize()
+        + Residency.GetAllocatedSize();
+    for (const TArray<FAssetQueueEntry>& Queue : PriorityQueues)
+    {
+        Size += Queue.GetAllocatedSize();
+    }
+    return Size;
+}
+
+int32 UAssetStreamingSubsystem::GetPendingRequestCount() const
+{
+    int32 Count = 0;
+    for (const int32 Depth : QueueDepths)
+    {
+        Count += Depth;
+    }
+    return Count;
+}
+
+bool UAssetStreamingSubsystem::EnqueueRequest(const uint32 SlotIndex)
+{
+    FAssetRequest& Request = Requests[SlotIndex];
+    Request.Serial = NextQueueSerial++;
+
+    TArray<FAssetQueueEntry>& Queue = GetQueue(Request.Priority);
+    const int32 QueueIndex = GetQueueIndex(Request.Priority);
+    if (&Queue != &DefaultQueue && Queue.Num() >= MaxPriorityQueueSize)
+    {
+        // If queue is full, remove the lowest priority. Queue holds at most MaxPriorityQueueSize live entries, so the scan is cheap
+        int32 LiveCount = 0;
+        int32 LowestIndex = INDEX_NONE;
+        for (int32 Index = 0; Index < Queue.Num(); ++Index)
+        {
+            if (!IsQueueEntryLive(Queue[Index]))
+            {
+                continue;
+            }
+            ++LiveCount;
+            if (LowestIndex == INDEX_NONE || FAssetQueueEntryPredicate()(Queue[LowestIndex], Queue[Index]))
+            {
+                LowestIndex = Index;
+            }
+        }
+
+        if (LiveCount >= MaxPriorityQueueSize)
+        {
+            if (Request.Priority <= Queue[LowestIndex].Priority)
+            {
+                FreeRequest(SlotIndex);
+                return false;
+            }
+            const uint32 LowestSlotIndex = Queue[LowestIndex].SlotIndex;
+            Queue.HeapRemoveAt(LowestIndex, FAssetQueueEntryPredicate(), EAllowShrinking::No);
+            FreeRequest(LowestSlotIndex);
+            --QueueDepths[QueueIndex];
+        }
+    }
+
+    ++QueueDepths[QueueIndex];
+    Queue.HeapPush(FAssetQueueEntry(SlotIndex, Request.Priority, Request.Serial), FAssetQueueEntryPredicate());
+    return true;
+}
+
+bool UAssetStreamingSubsystem::IsQueueEntryLive(const FAssetQueueEntry& Entry) const
+{
+    const FAssetRequest& Request = Requests[Entry.SlotIndex];
+    return Request.State == EAssetRequestState::Pending && Request.Serial == Entry.Serial;
+}
+
+bool UAssetStreamingSubsystem::PeekQueue(TArray<FAssetQueueEntry>& Queue, uint32& OutSlotIndex)
+{
+    while (Queue.Num() > 0)
+    {
+        if (IsQueueEntryLive(Queue.HeapTop()))
+        {
+            OutSlotIndex = Queue.HeapTop().SlotIndex;
+            return true;
+        }
+
+        Queue.HeapPopDiscard(FAssetQueueEntryPredicate(), EAllowShrinking::No);
+        StaleQueueEntryCount = FMath::Max(StaleQueueEntryCount - 1, 0);
+    }
+    return false;
+}
+
+bool UAssetStreamingSubsystem::PopQueue(TArray<FAssetQueueEntry>& Queue, uint32& OutSlotIndex)
+{
+    while (Queue.Num() > 0)
+    {
+        FAssetQueueEntry Entry(0, 0, 0);
+        Queue.HeapPop(Entry, FAssetQueueEntryPredicate(), EAllowShrinking::No);
+
+        if (!IsQueueEntryLive(Entry))
+        {
+            StaleQueueEntryCount = FMath::Max(StaleQueueEntryCount - 1, 0);
+            continue;
+        }
+
+        --QueueDepths[GetQueueIndex(Requests[Entry.SlotIndex].Priority)];
+        OutSlotIndex = Entry.SlotIndex;
+        return true;
+    }
+    return false;
+}
+
+void UAssetStreamingSubsystem::CompactQueues()
+{
+    auto IsStale = [this](const FAssetQueueEntry& Entry)
+        {
+            return !IsQueueEntryLive(Entry);
+        };
+
+    DefaultQueue.RemoveAll(IsStale);
+    DefaultQueue.Heapify(FAssetQueueEntryPredicate());
+    for (TArray<FAssetQueueEntry>& Queue : PriorityQueues)
+    {
+        Queue.RemoveAll(IsStale);
+        Queue.Heapify(FAssetQueueEntryPredicate());
+    }
+    StaleQueueEntryCount = 0;
+}
+
+void UAssetStreamingSubsystem::SetPreloadRoute(FName Route)
+{
+    if (Route == PreloadRoute)
+    {
+        return;
+    }
+
+    // What was recorded so far belongs to the old route
+    const FName MapName = PreloadMapName;
+    EndPreloadSession();
+    PreloadRoute = Route;
+    if (!MapName.IsNone())
+    {
+        PreloadMapName = MapName;
+        BeginPreloadSession();
+    }
+}
+
+void UAssetStreamingSubsystem::SetPreloadProgress(float Progress)
+{
+    PreloadProgress = Progress;
+    bExternalPreloadProgress = true;
+}
+
+bool UAssetStreamingSubsystem::SavePreloadRecording()
+{
+    if (PreloadMapName.IsNone() || RecordingManifest.Entries.Num() == 0)
+    {
+        return false;
+    }
+
+    RecordingManifest.MapName = PreloadMapName;
+    RecordingManifest.Route = PreloadRoute;
+    const FString Filename = FAssetPreloadManifest::GetManifestPath(PreloadMapName, PreloadRoute);
+    const bool bSaved = RecordingManifest.Save(Filename);
+    UE_LOG(LogAssetStreamingManager, Log, TEXT("Preload manifest: %s %d assets to '%s'."), bSaved ? TEXT("Saved") : TEXT("Failed to save"), RecordingManifest.Entries.Num(), *Filename);
+    return bSaved;
+}
+
+void UAssetStreamingSubsystem::OnPreLoadMap(const FString& MapName)
+{
+    SaveWarmSetCapture();
+    EndPreloadSession();
+
+    EndWarmSet();
+    if (StreamingManager::bWarmSet)
+    {
+        BeginWarmSet(StreamingManager::GetMapShortName(MapName));
+    }
+}
+
+void UAssetStreamingSubsystem::OnPostLoadMap(UWorld* World)
+{
+    if (!World || !World->IsGameWorld())
+    {
+        return;
+    }
+
+    EndPreloadSession();
+    PreloadMapName = StreamingManager::GetMapShortName(World->GetOutermost()->GetName());
+    PreloadTimeSeconds = 0.f;
+    PreloadProgress = 0.f;
+    bExternalPreloadProgress = false;
+    WarmSetCapture.Reset();
+    WarmSetCapturedAssets.Reset();
+    BeginPreloadSession();
+}
+
+void UAssetStreamingSubsystem::BeginPreloadSession()
+{
+    RecordingManifest.Reset();
+    RecordedAssets.Reset();
+
+    ReplayManifest.Reset();
+    ReplayRequests.Reset();
+    ReplayIssueCursor = 0;
+    ReplayReleaseCursor = 0;
+    if (!StreamingManager::bReplayPreloadManifest || !ReplayManifest.Load(FAssetPreloadManifest::GetManifestPath(PreloadMapName, PreloadRoute)))
+    {
+        return;
+    }
+
+    // Issued and released in progress order, progress set by the game is not necessarily monotonic while recording
+    Algo::StableSortBy(ReplayManifest.Entries, &FAssetPreloadManifestEntry::Progress);
+    ReplayRequests.SetNum(ReplayManifest.Entries.Num());
+    UE_LOG(LogAssetStreamingManager, Log, TEXT("Preload manifest: Replaying %d assets for %s/%s."), ReplayManifest.Entries.Num(), *PreloadMapName.ToString(), *PreloadRoute.ToString());
+}
+
+void UAssetStreamingSubsystem::EndPreloadSession()
+{
+    SavePreloadRecording();
+    RecordingManifest.Reset();
+    RecordedAssets.Reset();
+
+    for (int32 Index = ReplayReleaseCursor; Index < ReplayIssueCursor; ++Index)
+    {
+        ReleaseAsset(ReplayRequests[Index]);
+    }
+    ReplayManifest.Reset();
+    ReplayRequests.Reset();
+    ReplayIssueCursor = 0;
+    ReplayReleaseCursor = 0;
+    PreloadMapName = NAME_None;
+}
+
+void UAssetStreamingSubsystem::RecordPreloadRequest(const FSoftObjectPath& AssetPath)
+{
+    if (bIssuingReplay || PreloadMapName.IsNone())
+    {
+        return;
+    }
+
+    if (StreamingManager::bWarmSet && PreloadTimeSeconds <= StreamingManager::WarmSetCaptureSeconds
+        && WarmSetCapture.Entries.Num() < StreamingManager::WarmSetMaxAssets)
+    {
+        bool bAlreadyCaptured = false;
+        WarmSetCapturedAssets.Add(AssetPath, &bAlreadyCaptured);
+        if (!bAlreadyCaptured)
+        {
+            WarmSetCapture.Entries.Add({ AssetPath, PreloadTimeSeconds, PreloadProgress });
+        }
+    }
+
+    if (!StreamingManager::bRecordPreloadManifest)
+    {
+        return;
+    }
+
+    // Only the first request of an asset matters for prefetching
+    bool bAlreadyRecorded = false;
+    RecordedAssets.Add(AssetPath, &bAlreadyRecorded);
+    if (!bAlreadyRecorded)
+    {
+        RecordingManifest.Entries.Add({ AssetPath, PreloadTimeSeconds, PreloadProgress });
+    }
+}
+
+void UAssetStreamingSubsystem::UpdatePreloadReplay(float DeltaTime)
+{
+    PreloadTimeSeconds += DeltaTime;
+    if (!bExternalPreloadProgress)
+    {
+        PreloadProgress = PreloadTimeSeconds;
+    }
+
+    const TArray<FAssetPreloadManifestEntry>& Entries = ReplayManifest.Entries;
+    if (Entries.Num() == 0)
+    {
+        return;
+    }
+
+    // Low priority prefetch through the default queue, no faster than the queues are drained
+    TGuardValue<bool> IssuingReplayGuard(bIssuingReplay, true);
+    int32 Issued = 0;
+    while (ReplayIssueCursor < Entries.Num() && Issued < StreamingManager::MaxAssetsToLoadPerTick
+        && Entries[ReplayIssueCursor].Progress <= PreloadProgress + StreamingManager::PreloadLookahead)
+    {
+        RequestAssetStreaming(Entries[ReplayIssueCursor].AssetPath, ReplayRequests[ReplayIssueCursor], 0);
+        ++ReplayIssueCursor;
+        ++Issued;
+    }
+
+    while (ReplayReleaseCursor < ReplayIssueCursor && Entries[ReplayReleaseCursor].Progress + StreamingManager::PreloadRetain < PreloadProgress)
+    {
+        ReleaseAsset(ReplayRequests[ReplayReleaseCursor]);
+        ++ReplayReleaseCursor;
+    }
+}
+
+bool UAssetStreamingSubsystem::BeginWarmSet(FName MapName)
+{
+    EndWarmSet();
+
+    TArray<FSoftObjectPath> AssetPaths;
+    TSet<FSoftObjectPath> UniqueAssetPaths;
+    for (const FAssetWarmSet& WarmSet : AuthoredWarmSets)
+    {
+        if (WarmSet.MapName == MapName)
+        {
+            for (const FSoftObjectPath& AssetPath : WarmSet.Assets)
+            {
+                bool bAlreadyInSet = false;
+                UniqueAssetPaths.Add(AssetPath, &bAlreadyInSet);
+                if (!bAlreadyInSet && !AssetPath.IsNull())
+                {
+                    AssetPaths.Add(AssetPath);
+                }
+            }
+        }
+    }
+
+    FAssetPreloadManifest Captured;
+    if (Captured.Load(FAssetPreloadManifest::GetWarmSetPath(MapName)))
+    {
+        for (const FAssetPreloadManifestEntry& Entry : Captured.Entries)
+        {
+            bool bAlreadyInSet = false;
+            UniqueAssetPaths.Add(Entry.AssetPath, &bAlreadyInSet);
+            if (!bAlreadyInSet && !Entry.AssetPath.IsNull())
+            {
+                AssetPaths.Add(Entry.AssetPath);
+            }
+        }
+    }
+
+    if (AssetPaths.Num() == 0)
+    {
+        return false;
+    }
+
+    UE_LOG(LogAssetStreamingManager, Log, TEXT("Warm set: Loading %d assets for %s."), AssetPaths.Num(), *MapName.ToString());
+    WarmSetPreviousMode = StreamingMode;
+    SetStreamingMode(EAssetStreamingMode::Burst);
+    WarmSetLoadedCount = 0;
+    WarmSetTotalCount = AssetPaths.Num();
+    bLoadingWarmSet = true;
+
+    // All issued now, the game thread may not tick again before the loading screen is gone and the async loader orders them anyway
+    TGuardValue<bool> IssuingReplayGuard(bIssuingReplay, true);
+    WarmSetRequests.Reserve(AssetPaths.Num());
+    for (const FSoftObjectPath& AssetPath : AssetPaths)
+    {
+        const FAssetRequestHandle RequestHandle = AllocateRequest(AssetPath, 0);
+        Requests[RequestHandle.Index].OnCompleted = FOnAssetRequestCompleted::CreateUObject(this, &UAssetStreamingSubsystem::OnWarmSetAssetLoaded);
+        WarmSetRequests.Add(RequestHandle);
+        StreamAsset(RequestHandle.Index);
+    }
+    return true;
+}
+
+void UAssetStreamingSubsystem::EndWarmSet()
+{
+    if (bLoadingWarmSet && StreamingMode == EAssetStreamingMode::Burst)
+    {
+        SetStreamingMode(WarmSetPreviousMode);
+    }
+
+    ReleaseAssets(WarmSetRequests);
+    WarmSetRequests.Reset();
+    WarmSetLoadedCount = 0;
+    WarmSetTotalCount = 0;
+    bLoadingWarmSet = false;
+    WarmSetRetainTime = 0.f;
+}
+
+float UAssetStreamingSubsystem::GetWarmSetProgress() const
+{
+    const int32 TotalCount = WarmSetTotalCount;
+    return TotalCount > 0 ? FMath::Clamp(static_cast<float>(WarmSetLoadedCount) / TotalCount, 0.f, 1.f) : 1.f;
+}
+
+void UAssetStreamingSubsystem::OnWarmSetAssetLoaded(const FSoftObjectPath& AssetPath, bool bAlreadyLoaded)
+{
+    if (++WarmSetLoadedCount < WarmSetTotalCount || !bLoadingWarmSet)
+    {
+        return;
+    }
+
+    UE_LOG(LogAssetStreamingManager, Log, TEXT("Warm set: Loaded %d assets."), WarmSetTotalCount.load());
+    bLoadingWarmSet = false;
+    WarmSetRetainTime = StreamingManager::WarmSetRetainSeconds;
+    // Left alone if the game switched modes on its own in the meantime
+    if (StreamingMode == EAssetStreamingMode::Burst)
+    {
+        SetStreamingMode(WarmSetPreviousMode);
+    }
+}
+
+void UAssetStreamingSubsystem::UpdateWarmSet(float DeltaTime)
+{
+    if (bLoadingWarmSet || WarmSetRequests.Num() == 0)
+    {
+        return;
+    }
+
+    WarmSetRetainTime -= DeltaTime;
+    if (WarmSetRetainTime <= 0.f)
+    {
+        EndWarmSet();
+    }
+}
+
+bool UAssetStreamingSubsystem::SaveWarmSetCapture()
+{
+    // A session that ended within the capture window only saw part of it, keep the previous capture
+    if (PreloadMapName.IsNone() || WarmSetCapture.Entries.Num() == 0 || PreloadTimeSeconds < StreamingManager::WarmSetCaptureSeconds)
+    {
+        return false;
+    }
+
+    WarmSetCapture.MapName = PreloadMapName;
+    const FString Filename = FAssetPreloadManifest::GetWarmSetPath(PreloadMapName);
+    const bool bSaved = WarmSetCapture.Save(Filename);
+    UE_LOG(LogAssetStreamingManager, Log, TEXT("Warm set: %s %d assets to '%s'."), bSaved ? TEXT("Captured") : TEXT("Failed to save"), WarmSetCapture.Entries.Num(), *Filename);
+    WarmSetCapture.Reset();
+    WarmSetCapturedAssets.Reset();
+    return bSaved;
+}
+
+void UAssetStreamingSubsystem::StreamAsset(const uint32 SlotIndex)
+{
+    FAssetRequest& Request = Requests[SlotIndex];
+    const FSoftObjectPath AssetPath = Request.AssetPath;
+    if (AssetPath.IsNull())
+    {
+        FreeRequest(SlotIndex);
+        return;
+    }
+
+    const FAssetRequestHandle RequestHandle(SlotIndex, Request.Generation);
+    const bool bIsAssetLoaded = IsAssetLoadComplete(AssetPath);
+    Request.State = EAssetRequestState::Streaming;
+    if (!bIsAssetLoaded)
+    {
+        // Set before issuing, RequestAsyncLoad may complete synchronously
+        BeginInFlight(Request);
+    }
+
+    TSharedPtr<FStreamableHandle> Handle = IssueAsyncLoad(SlotIndex, bIsAssetLoaded);
+    if (!bIsAssetLoaded)
+    {
+        PrefetchDependencies(AssetPath, Requests[SlotIndex].AsyncLoadPriority);
+    }
+
+    if (UnloadTimers.Cancel(AssetPath))
+    {
+        Telemetry.RecordUnloadDelayHit();
+    }
+
+    if (!KeepAlive.Contains(AssetPath))
+    {
+        KeepAlive.Add(AssetPath, Handle);
+        const int64 EstimatedBytes = GetEstimatedPackageSize(AssetPath.GetLongPackageFName());
+        Residency.Add(AssetPath, GetAssetStreamingCategory(AssetPath), EstimatedBytes > 0 ? EstimatedBytes : StreamingManager::UnknownAssetSizeKB * 1024ll);
+    }
+    else
+    {
+        Residency.MarkRequested(AssetPath);
+    }
+
+    AssetRequestCount.FindOrAdd(AssetPath)++;
+
+#if WITH_EDITOR
+    if(StreamingManager::CVarbForceLoadComplete->GetBool())
+    {
+        HandleAssetLoaded(RequestHandle, AssetPath, true);
+	}
+#endif
+}
+
+void UAssetStreamingSubsystem::UnloadAsset(const FSoftObjectPath& AssetPath)
+{
+    KeepAlive.Remove(AssetPath);
+    Residency.Remove(AssetPath);
+    ReleasePrefetches(AssetPath);
+
+    TArray<TSharedRef<FStreamableHandle>> Handles;
+    if (StreamableManager.GetActiveHandles(AssetPath, Handles, true))
+    {
+        for (TSharedRef<FStreamableHandle> Handle : Handles)
+        {
+            Handle->CancelHandle();
+        }
+    }
+}
+
+void UAssetStreamingSubsystem::EvictOverBudgetAssets()
+{
+    // Each category only gives up its own released assets, a burst of audio never unloads meshes
+    TArray<FSoftObjectPath> ToEvict;
+    Residency.GatherEvictions(ToEvict);
+    for (const FSoftObjectPath& Path : ToEvict)
+    {
+        UnloadTimers.Cancel(Path);
+        Residency.RecordEvicted(Path);
+        UnloadAsset(Path);
+    }
+}
+
+int32 UAssetStreamingSubsystem::FindStreamingCategory(const FName CategoryName) const
+{
+    if (CategoryName == StreamingManager::OtherCategoryName)
+    {
+        return StreamingCategories.Num();
+    }
+    return StreamingCategories.IndexOfByPredicate([CategoryName](const FAssetStreamingCategory& Category)
+        {
+            return Category.Name == CategoryName;
+        });
+}
 
-    AssetRequestCount.FindOrAdd(AssetPath)++;
+FName UAssetStreamingSubsystem::GetStreamingCategoryName(const int32 Category) const
+{
+    return StreamingCategories.IsValidIndex(Category) ? StreamingCategories[Category].Name : StreamingManager::OtherCategoryName;
+}
 
-#if WITH_EDITOR
-    if(StreamingManager::CVarbForceLoadComplete->GetBool())
+int32 UAssetStreamingSubsystem::GetAssetStreamingCategory(const FSoftObjectPath& AssetPath) const
+{
+    const int32 OtherCategory = StreamingCategories.Num();
+    if (OtherCategory == 0)
     {
-        HandleAssetLoaded(AssetPath, true);
-	}
+        return OtherCategory;
+    }
+
+    IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(AssetPath);
+    if (!AssetData.IsValid())
+    {
+        return OtherCategory;
+    }
+
+    FName TaggedCategory;
+    if (AssetData.GetTagValue(StreamingManager::CategoryTagName, TaggedCategory))
+    {
+        const int32 Category = FindStreamingCategory(TaggedCategory);
+        if (Category != INDEX_NONE)
+        {
+            return Category;
+        }
+    }
+
+    for (int32 Category = 0; Category < StreamingCategories.Num(); ++Category)
+    {
+        if (StreamingCategories[Category].AssetClasses.Contains(AssetData.AssetClassPath))
+        {
+            return Category;
+        }
+    }
+    return OtherCategory;
+}
+
+bool UAssetStreamingSubsystem::SetStreamingCategoryBudget(const FName CategoryName, const int64 BudgetBytes)
+{
+    const int32 Category = FindStreamingCategory(CategoryName);
+    if (Category == INDEX_NONE)
+    {
+        return false;
+    }
+
+    Residency.SetBudget(Category, BudgetBytes);
+    return true;
+}
+
+TSharedPtr<FStreamableHandle> UAssetStreamingSubsystem::IssueAsyncLoad(const uint32 SlotIndex, const bool bAlreadyLoaded)
+{
+    const FAssetRequestHandle RequestHandle(SlotIndex, Requests[SlotIndex].Generation);
+    const FSoftObjectPath AssetPath = Requests[SlotIndex].AssetPath;
+    const TAsyncLoadPriority AsyncLoadPriority = GetAsyncLoadPriority(Requests[SlotIndex].Priority);
+
+    FStreamableDelegate OnLoaded;
+    OnLoaded.BindLambda([WeakThis = MakeWeakObjectPtr(this), RequestHandle, AssetPath, bAlreadyLoaded]()
+        {
+            if (WeakThis.IsValid())
+            {
+                WeakThis->HandleAssetLoaded(RequestHandle, AssetPath, bAlreadyLoaded);
+            }
+        });
+
+    TSharedPtr<FStreamableHandle> Handle = RequestAsyncLoad(AssetPath, MoveTemp(OnLoaded), AsyncLoadPriority);
+
+    // RequestAsyncLoad may complete synchronously, re-fetch the slot after it
+    Requests[SlotIndex].Handle = Handle;
+    Requests[SlotIndex].AsyncLoadPriority = AsyncLoadPriority;
+    return Handle;
+}
+
+bool UAssetStreamingSubsystem::IsAssetLoadComplete(const FSoftObjectPath& AssetPath) const
+{
+    return StreamableManager.IsAsyncLoadComplete(AssetPath);
+}
+
+TSharedPtr<FStreamableHandle> UAssetStreamingSubsystem::RequestAsyncLoad(const FSoftObjectPath& AssetPath, FStreamableDelegate OnLoaded, const TAsyncLoadPriority AsyncLoadPriority)
+{
+    return StreamableManager.RequestAsyncLoad(AssetPath, MoveTemp(OnLoaded), AsyncLoadPriority, true);
+}
+
+void UAssetStreamingSubsystem::EscalateInFlightRequest(const uint32 SlotIndex)
+{
+    const FAssetRequest& Request = Requests[SlotIndex];
+    const TSharedPtr<FStreamableHandle> OldHandle = Request.Handle;
+    if (!OldHandle.IsValid() || !OldHandle->IsLoadingInProgress() || GetAsyncLoadPriority(Request.Priority) <= Request.AsyncLoadPriority)
+    {
+        // Already loaded, or a demotion. The async loader can only raise the priority of a package in flight
+        return;
+    }
+
+    // Requesting a package that is already loading with a higher priority raises the priority of the
+    // existing package in the async loader, then the old handle is swapped out without touching the load.
+    const FSoftObjectPath AssetPath = Request.AssetPath;
+    TSharedPtr<FStreamableHandle> NewHandle = IssueAsyncLoad(SlotIndex, false);
+    PrefetchDependencies(AssetPath, Requests[SlotIndex].AsyncLoadPriority);
+
+    if (TSharedPtr<FStreamableHandle>* KeepAliveHandle = KeepAlive.Find(AssetPath))
+    {
+        if (*KeepAliveHandle == OldHandle)
+        {
+            *KeepAliveHandle = NewHandle;
+        }
+    }
+    OldHandle->CancelHandle();
+}
+
+const TArray<FName>& UAssetStreamingSubsystem::GetHardDependencies(const FName PackageName)
+{
+    const int32 MaxDepth = FMath::Max(StreamingManager::PrefetchDependencyDepth, 1);
+    if (DependencyCacheDepth != MaxDepth)
+    {
+        DependencyCache.Empty();
+        DependencyCacheDepth = MaxDepth;
+    }
+
+    if (const TArray<FName>* Cached = DependencyCache.Find(PackageName))
+    {
+        return *Cached;
+    }
+
+    // Bounded, starting over is cheaper than tracking which entries are still useful
+    if (DependencyCache.Num() >= FMath::Max(StreamingManager::MaxDependencyCacheEntries, 1))
+    {
+        DependencyCache.Reset();
+    }
+
+    IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+    // Breadth first so the closest dependencies come first in the list
+    TArray<FName> Dependencies;
+    TSet<FName> Visited;
+    Visited.Add(PackageName);
+    TArray<FName> Frontier = { PackageName };
+    TArray<FName> Next;
+    TArray<FName> Found;
+    for (int32 Depth = 0; Depth < MaxDepth && Frontier.Num() > 0; ++Depth)
+    {
+        Next.Reset();
+        for (const FName Current : Frontier)
+        {
+            Found.Reset();
+            AssetRegistry.GetDependencies(Current, Found, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+            for (const FName Dependency : Found)
+            {
+                bool bAlreadyVisited = false;
+                Visited.Add(Dependency, &bAlreadyVisited);
+                if (bAlreadyVisited || FPackageName::IsScriptPackage(Dependency.ToString()))
+                {
+                    continue;
+                }
+                Dependencies.Add(Dependency);
+                Next.Add(Dependency);
+            }
+        }
+        Swap(Frontier, Next);
+    }
+
+    return DependencyCache.Add(PackageName, MoveTemp(Dependencies));
+}
+
+void UAssetStreamingSubsystem::PrefetchDependencies(const FSoftObjectPath& AssetPath, const TAsyncLoadPriority AsyncLoadPriority)
+{
+    if (!StreamingManager::bPrefetchDependencies)
+    {
+        return;
+    }
+
+    const FName PackageName = AssetPath.GetLongPackageFName();
+    if (PackageName.IsNone())
+    {
+        return;
+    }
+
+    TArray<FName>& OwnedPrefetches = PrefetchOwners.FindOrAdd(AssetPath);
+    for (const FName Dependency : GetHardDependencies(PackageName))
+    {
+        // Escalating a request prefetches again, each dependency is held once per owner
+        if (!OwnedPrefetches.Contains(Dependency))
+        {
+            OwnedPrefetches.Add(Dependency);
+            ++PrefetchRefCounts.FindOrAdd(Dependency);
+        }
+
+        if (UPackage* LoadedPackage = FindObjectFast<UPackage>(nullptr, Dependency))
+        {
+            HoldPrefetch(Dependency, LoadedPackage);
+            continue;
+        }
+
+        TAsyncLoadPriority* IssuedPriority = InFlightPrefetches.Find(Dependency);
+        if (IssuedPriority && *IssuedPriority >= AsyncLoadPriority)
+        {
+            continue;
+        }
+
+        // Issuing again with a higher priority raises the package already in flight
+        InFlightPrefetches.Add(Dependency, AsyncLoadPriority);
+        LoadPackageAsync(Dependency.ToString(), FLoadPackageAsyncDelegate::CreateWeakLambda(this,
+            [this](const FName& LoadedPackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+            {
+                InFlightPrefetches.Remove(LoadedPackageName);
+                if (Result == EAsyncLoadingResult::Succeeded)
+                {
+                    Telemetry.RecordBytesLoaded(GetEstimatedPackageSize(LoadedPackageName));
+                    // Nothing to hold once every owner has loaded
+                    if (LoadedPackage && PrefetchRefCounts.Contains(LoadedPackageName))
+                    {
+                        HoldPrefetch(LoadedPackageName, LoadedPackage);
+                    }
+                }
+            }), AsyncLoadPriority);
+    }
+}
+
+void UAssetStreamingSubsystem::HoldPrefetch(const FName PackageName, UPackage* Package)
+{
+    if (HeldPrefetches.Contains(PackageName))
+    {
+        return;
+    }
+
+    // Only public objects are imported by the owning asset, they keep the package's private objects they use alive
+    TArray<UObject*> PackageObjects;
+    GetObjectsWithPackage(Package, PackageObjects, false);
+    FAssetPrefetchedPackage& Held = HeldPrefetches.Add(PackageName);
+    for (UObject* Object : PackageObjects)
+    {
+        if (Object->HasAnyFlags(RF_Public))
+        {
+            Held.Objects.Add(Object);
+        }
+    }
+}
+
+void UAssetStreamingSubsystem::ReleasePrefetches(const FSoftObjectPath& AssetPath)
+{
+    TArray<FName> OwnedPrefetches;
+    if (!PrefetchOwners.RemoveAndCopyValue(AssetPath, OwnedPrefetches))
+    {
+        return;
+    }
+
+    for (const FName Dependency : OwnedPrefetches)
+    {
+        int32* RefCount = PrefetchRefCounts.Find(Dependency);
+        if (RefCount && --(*RefCount) <= 0)
+        {
+            PrefetchRefCounts.Remove(Dependency);
+            HeldPrefetches.Remove(Dependency);
+        }
+    }
+}
+
+void UAssetStreamingSubsystem::HandleAssetLoaded(const FAssetRequestHandle RequestHandle, const FSoftObjectPath& AssetPath, bool bAlreadyLoaded)
+{
+    // Resident bytes start as the package disk size, the loaded asset's memory replaces it once
+    if (Residency.Contains(AssetPath) && !Residency.IsMeasured(AssetPath))
+    {
+        if (UObject* LoadedAsset = AssetPath.ResolveObject())
+        {
+            Residency.SetMeasuredBytes(AssetPath, LoadedAsset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal));
+        }
+    }
+
+    // The asset has imported its dependencies, they are kept alive by it from here on
+    ReleasePrefetches(AssetPath);
+
+    if (OnAssetLoaded.IsBound())
+    {
+        UObject* LoadedAsset = AssetPath.ResolveObject();
+        if (LoadedAsset)
+        {
+            OnAssetLoaded.Broadcast(LoadedAsset, bAlreadyLoaded);
+        }
+    }
+
+    // Released requests have a stale handle here and get no callback
+    FAssetRequest* Request = ResolveRequest(RequestHandle);
+    if (!Request)
+    {
+        return;
+    }
+
+    RecordRequestLoaded(*Request, bAlreadyLoaded);
+    // Loaded, distance no longer matters
+    UntrackSpatialRequest(*Request);
+
+    if (TSharedPtr<TPromise<UObject*>> UrgentPromise = MoveTemp(Request->UrgentPromise))
+    {
+        UrgentPromise->SetValue(AssetPath.ResolveObject());
+        // A continuation on the future may have released or re-requested
+        Request = ResolveRequest(RequestHandle);
+        if (!Request)
+        {
+            return;
+        }
+    }
+
+    if (UObject* CallbackObject = Request->CallbackObject.Get())
+    {
+        Request->CallbackObject.Reset();
+        IAssetStreamingCallback::Execute_OnAssetLoaded(CallbackObject, TSoftObjectPtr<UObject>(AssetPath), bAlreadyLoaded);
+        ReleaseCallbackWrapper(CallbackObject);
+        // The callback may have released or re-requested, the slot array can have moved
+        Request = ResolveRequest(RequestHandle);
+    }
+
+    if (!Request || !Request->OnCompleted.IsBound())
+    {
+        return;
+    }
+
+    FOnAssetRequestCompleted OnCompleted = MoveTemp(Request->OnCompleted);
+    Request->OnCompleted.Unbind();
+    if (Request->CompletionThread == ENamedThreads::GameThread && IsInGameThread())
+    {
+        OnCompleted.Execute(AssetPath, bAlreadyLoaded);
+    }
+    else
+    {
+        AsyncTask(Request->CompletionThread, [OnCompleted = MoveTemp(OnCompleted), AssetPath, bAlreadyLoaded]()
+            {
+                OnCompleted.ExecuteIfBound(AssetPath, bAlreadyLoaded);
+            });
+    }
+}
+
+int64 UAssetStreamingSubsystem::GetEstimatedPackageSize(const FName PackageName)
+{
+    if (PackageName.IsNone())
+    {
+        return 0;
+    }
+
+    if (const int64* Cached = PackageSizeCache.Find(PackageName))
+    {
+        return *Cached;
+    }
+
+    // Cooked registries may not carry package data, those packages count as 0 bytes
+    IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+    const int64 Size = PackageData.IsSet() ? FMath::Max<int64>(PackageData->DiskSize, 0) : 0;
+    return PackageSizeCache.Add(PackageName, Size);
+}
+
+bool UAssetStreamingSubsystem::HasStreamingBudget(const uint32 SlotIndex)
+{
+    const FAssetRequest& Request = Requests[SlotIndex];
+    const int32 Class = static_cast<int32>(GetPriorityClass(Request.Priority));
+    const FAssetStreamingBudget& Budget = StreamingBudgets[static_cast<int32>(StreamingMode)][Class];
+    // Already loaded assets cost no I/O
+    if (InFlightRequests[Class] == 0 || (Budget.MaxInFlightRequests <= 0 && Budget.MaxInFlightBytes <= 0) || IsAssetLoadComplete(Request.AssetPath))
+    {
+        return true;
+    }
+
+    if (Budget.MaxInFlightRequests > 0 && InFlightRequests[Class] >= Budget.MaxInFlightRequests)
+    {
+        return false;
+    }
+
+    if (Budget.MaxInFlightBytes > 0)
+    {
+        const int64 EstimatedBytes = GetEstimatedPackageSize(Request.AssetPath.GetLongPackageFName());
+        const int64 Bytes = EstimatedBytes > 0 ? EstimatedBytes : StreamingManager::UnknownAssetSizeKB * 1024ll;
+        return InFlightBytes[Class] + Bytes <= Budget.MaxInFlightBytes;
+    }
+    return true;
+}
+
+void UAssetStreamingSubsystem::BeginInFlight(FAssetRequest& Request)
+{
+    Request.EstimatedBytes = GetEstimatedPackageSize(Request.AssetPath.GetLongPackageFName());
+    Request.GovernorBytes = Request.EstimatedBytes > 0 ? Request.EstimatedBytes : StreamingManager::UnknownAssetSizeKB * 1024ll;
+    Request.InFlightClass = GetPriorityClass(Request.Priority);
+    Request.bInFlight = true;
+
+    const int32 Class = static_cast<int32>(Request.InFlightClass);
+    InFlightBytes[Class] += Request.GovernorBytes;
+    ++InFlightRequests[Class];
+    ++InFlightRequestCount;
+}
+
+void UAssetStreamingSubsystem::EndInFlight(FAssetRequest& Request)
+{
+    if (!Request.bInFlight)
+    {
+        return;
+    }
+
+    const int32 Class = static_cast<int32>(Request.InFlightClass);
+    InFlightBytes[Class] -= Request.GovernorBytes;
+    --InFlightRequests[Class];
+    --InFlightRequestCount;
+    Request.bInFlight = false;
+    Request.GovernorBytes = 0;
+}
+
+void UAssetStreamingSubsystem::RecordRequestLoaded(FAssetRequest& Request, bool bAlreadyLoaded)
+{
+    if (Request.bInFlight)
+    {
+        Telemetry.RecordBytesLoaded(Request.EstimatedBytes);
+        EndInFlight(Request);
+    }
+
+    if (Request.RequestTime <= 0.0)
+    {
+        // Already recorded, StreamingManager.bForceImmediateLoadComplete completes twice
+        return;
+    }
+
+    const double LatencySeconds = FPlatformTime::Seconds() - Request.RequestTime;
+    Request.RequestTime = 0.0;
+    Telemetry.RecordLoaded(GetQueueIndex(Request.Priority), LatencySeconds);
+
+#if UE_TRACE_ENABLED
+    if (UE_TRACE_CHANNELEXPR_IS_ENABLED(AssetStreamingChannel))
+    {
+        const FString PathString = Request.AssetPath.ToString();
+        UE_TRACE_LOG(AssetStreaming, RequestLoaded, AssetStreamingChannel)
+            << RequestLoaded.Cycle(FPlatformTime::Cycles64())
+            << RequestLoaded.LatencySeconds(LatencySeconds)
+            << RequestLoaded.Priority(Request.Priority)
+            << RequestLoaded.Bytes(Request.EstimatedBytes)
+            << RequestLoaded.bAlreadyLoaded(bAlreadyLoaded)
+            << RequestLoaded.AssetPath(*PathString, PathString.Len());
+    }
+#endif
+}
+
+void UAssetStreamingSubsystem::PublishTelemetry(float DeltaTime)
+{
+    Telemetry.Tick(DeltaTime);
+
+    const int32 PendingRequestCount = GetPendingRequestCount();
+    const FAssetStreamingLatencyHistogram& Latency = Telemetry.GetTotalLatency();
+
+    SET_DWORD_STAT(STAT_ASMPendingRequests, PendingRequestCount);
+    SET_DWORD_STAT(STAT_ASMDefaultQueueDepth, QueueDepths[0]);
+    SET_DWORD_STAT(STAT_ASMPriorityQueueDepth, PendingRequestCount - QueueDepths[0]);
+    SET_DWORD_STAT(STAT_ASMInFlightRequests, InFlightRequestCount);
+    SET_DWORD_STAT(STAT_ASMPendingUnloads, UnloadTimers.Num());
+    SET_FLOAT_STAT(STAT_ASMLatencyP50, Latency.GetPercentile(0.50) * 1000.0);
+    SET_FLOAT_STAT(STAT_ASMLatencyP95, Latency.GetPercentile(0.95) * 1000.0);
+    SET_FLOAT_STAT(STAT_ASMLatencyP99, Latency.GetPercentile(0.99) * 1000.0);
+    SET_FLOAT_STAT(STAT_ASMLoadedKBPerSecond, Telemetry.GetBytesPerSecond() / 1024.0);
+    SET_FLOAT_STAT(STAT_ASMInFlightMB, (InFlightBytes[0] + InFlightBytes[1] + InFlightBytes[2]) / (1024.0 * 1024.0));
+
+    int64 ResidentBytes = 0;
+    int64 EvictionCount = 0;
+    for (int32 Category = 0; Category < Residency.NumCategories(); ++Category)
+    {
+        ResidentBytes += Residency.GetResidentBytes(Category);
+        EvictionCount += Residency.GetEvictionCount(Category);
+    }
+    SET_FLOAT_STAT(STAT_ASMResidentMB, ResidentBytes / (1024.0 * 1024.0));
+    SET_DWORD_STAT(STAT_ASMBudgetEvictions, EvictionCount);
+
+    TRACE_COUNTER_SET(AssetStreaming_PendingRequests, PendingRequestCount);
+    TRACE_COUNTER_SET(AssetStreaming_InFlightRequests, InFlightRequestCount);
+    TRACE_COUNTER_SET(AssetStreaming_LoadedBytesPerSecond, static_cast<int64>(Telemetry.GetBytesPerSecond()));
+
+#if CSV_PROFILER
+    if (!FCsvProfiler::Get()->IsCapturing())
+    {
+        return;
+    }
+
+    CSV_CUSTOM_STAT(AssetStreamingManager, PendingRequests, PendingRequestCount, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(AssetStreamingManager, InFlightRequests, InFlightRequestCount, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(AssetStreamingManager, PendingUnloads, UnloadTimers.Num(), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(AssetStreamingManager, LoadedKBPerSecond, static_cast<float>(Telemetry.GetBytesPerSecond() / 1024.0), ECsvCustomStatOp::Set);
+
+    // Depth and latency percentiles per queue, Default then Group0..GroupN
+    struct FQueueStatNames
+    {
+        FName Depth, P50, P95, P99;
+    };
+    static const TArray<FQueueStatNames> QueueStatNames = []()
+        {
+            TArray<FQueueStatNames> Names;
+            for (int32 QueueIndex = 0; QueueIndex < PriorityGroupCount + 1; ++QueueIndex)
+            {
+                const FString Suffix = QueueIndex == 0 ? FString(TEXT("Default")) : FString::Printf(TEXT("Group%d"), QueueIndex - 1);
+                Names.Add({ FName(TEXT("QueueDepth_") + Suffix), FName(TEXT("LatencyP50Ms_") + Suffix),
+                    FName(TEXT("LatencyP95Ms_") + Suffix), FName(TEXT("LatencyP99Ms_") + Suffix) });
+            }
+            return Names;
+        }();
+
+    const uint32 CategoryIndex = CSV_CATEGORY_INDEX(AssetStreamingManager);
+    for (int32 QueueIndex = 0; QueueIndex < PriorityGroupCount + 1; ++QueueIndex)
+    {
+        const FAssetStreamingLatencyHistogram& QueueLatency = Telemetry.GetQueueLatency(QueueIndex);
+        FCsvProfiler::RecordCustomStat(QueueStatNames[QueueIndex].Depth, CategoryIndex, QueueDepths[QueueIndex], ECsvCustomStatOp::Set);
+        FCsvProfiler::RecordCustomStat(QueueStatNames[QueueIndex].P50, CategoryIndex, static_cast<float>(QueueLatency.GetPercentile(0.50) * 1000.0), ECsvCustomStatOp::Set);
+        FCsvProfiler::RecordCustomStat(QueueStatNames[QueueIndex].P95, CategoryIndex, static_cast<float>(QueueLatency.GetPercentile(0.95) * 1000.0), ECsvCustomStatOp::Set);
+        FCsvProfiler::RecordCustomStat(QueueStatNames[QueueIndex].P99, CategoryIndex, static_cast<float>(QueueLatency.GetPercentile(0.99) * 1000.0), ECsvCustomStatOp::Set);
+    }
+
+    // Current and peak resident MB per streaming category
+    for (int32 Category = 0; Category < ResidencyStatNames.Num(); ++Category)
+    {
+        FCsvProfiler::RecordCustomStat(ResidencyStatNames[Category].Key, CategoryIndex, static_cast<float>(Residency.GetResidentBytes(Category) / (1024.0 * 1024.0)), ECsvCustomStatOp::Set);
+        FCsvProfiler::RecordCustomStat(ResidencyStatNames[Category].Value, CategoryIndex, static_cast<float>(Residency.GetPeakResidentBytes(Category) / (1024.0 * 1024.0)), ECsvCustomStatOp::Set);
+    }
 #endif
 }
 
-void UAssetStreamingSubsystem::HandleAssetLoaded(const FSoftObjectPath& AssetPath, bool bAlreadyLoaded)
+void UAssetStreamingSubsystem::DumpQueues(FOutputDevice& Ar) const
 {
-    UObject* LoadedAsset = AssetPath.ResolveObject();
-    if (LoadedAsset)
+    constexpr int32 MaxEntriesPerQueue = 32;
+    const double Now = FPlatformTime::Seconds();
+
+    auto DumpQueue = [this, &Ar, Now](const FString& Name, const TArray<FAssetQueueEntry>& Queue)
+        {
+            TArray<FAssetQueueEntry> LiveEntries = Queue.FilterByPredicate([this](const FAssetQueueEntry& Entry)
+                {
+                    return IsQueueEntryLive(Entry);
+                });
+            if (LiveEntries.Num() == 0)
+            {
+                return;
+            }
+            LiveEntries.Sort(FAssetQueueEntryPredicate());
+
+            Ar.Logf(TEXT("%s: %d pending, %d heap entries"), *Name, LiveEntries.Num(), Queue.Num());
+            for (int32 Index = 0; Index < FMath::Min(LiveEntries.Num(), MaxEntriesPerQueue); ++Index)
+            {
+                const FAssetRequest& Request = Requests[LiveEntries[Index].SlotIndex];
+                Ar.Logf(TEXT("    [%u] Priority %d, waiting %.3fs, %s"), LiveEntries[Index].SlotIndex, Request.Priority, Now - Request.RequestTime, *Request.AssetPath.ToString());
+            }
+            if (LiveEntries.Num() > MaxEntriesPerQueue)
+            {
+                Ar.Logf(TEXT("    ... %d more"), LiveEntries.Num() - MaxEntriesPerQueue);
+            }
+        };
+
+    Ar.Logf(TEXT("AssetStreamingManager: %d pending, %d in flight, %d pending unloads, %d stale queue entries"),
+        GetPendingRequestCount(), InFlightRequestCount, UnloadTimers.Num(), StaleQueueEntryCount);
+
+    for (int32 Class = 0; Class < PriorityClassCount; ++Class)
+    {
+        const FAssetStreamingBudget& Budget = StreamingBudgets[static_cast<int32>(StreamingMode)][Class];
+        Ar.Logf(TEXT("%s mode, %s class: %d requests / %.2f MB in flight, budget %d requests / %.2f MB (0 is unlimited)"),
+            *UEnum::GetDisplayValueAsText(StreamingMode).ToString(), *UEnum::GetDisplayValueAsText(static_cast<EAssetStreamingPriorityClass>(Class)).ToString(),
+            InFlightRequests[Class], InFlightBytes[Class] / (1024.0 * 1024.0), Budget.MaxInFlightRequests, Budget.MaxInFlightBytes / (1024.0 * 1024.0));
+    }
+
+    for (int32 Bucket = PriorityGroupCount - 1; Bucket >= 0; --Bucket)
     {
-        OnAssetLoaded.Broadcast(LoadedAsset, bAlreadyLoaded);
+        DumpQueue(FString::Printf(TEXT("PriorityQueue[%d]"), Bucket), PriorityQueues[Bucket]);
     }
-}
\ No newline at end of file
+    DumpQueue(TEXT("DefaultQueue"), DefaultQueue);
+
+    int32 InFlightLogged = 0;
+    for (int32 SlotIndex = 0; SlotIndex < Requests.Num() && InFlightLogged < MaxEntriesPerQueue; ++SlotIndex)
+    {
+        const FAssetRequest& Request = Requests[SlotIndex];
+        if (Request.bInFlight)
+        {
+            Ar.Logf(TEXT("In flight [%d] Priority %d (async %d), %.3fs since request, %lld bytes, %s"), SlotIndex, Request.Priority,
+                Request.AsyncLoadPriority, Now - Request.RequestTime, Request.EstimatedBytes, *Request.AssetPath.ToString());
+            ++InFlightLogged;
+        }
+    }
+
+    Ar.Logf(TEXT("Latency (ms)        Count       P50       P95       P99       Max"));
+    auto DumpLatency = [&Ar](const FString& Name, const FAssetStreamingLatencyHistogram& Histogram)
+        {
+            if (Histogram.Num() > 0)
+            {
+                Ar.Logf(TEXT("%-12s %12lld %9.2f %9.2f %9.2f %9.2f"), *Name, Histogram.Num(), Histogram.GetPercentile(0.50) * 1000.0,
+                    Histogram.GetPercentile(0.95) * 1000.0, Histogram.GetPercentile(0.99) * 1000.0, Histogram.GetMax() * 1000.0);
+            }
+        };
+    for (int32 QueueIndex = Telemetry.NumQueues() - 1; QueueIndex >= 0; --QueueIndex)
+    {
+        DumpLatency(QueueIndex == 0 ? FString(TEXT("Default")) : FString::Printf(TEXT("Group %d"), QueueIndex - 1), Telemetry.GetQueueLatency(QueueIndex));
+    }
+    DumpLatency(TEXT("All"), Telemetry.GetTotalLatency());
+
+    Ar.Logf(TEXT("Category        Resident MB    Peak MB  Budget MB   Assets  Released  Evictions"));
+    for (int32 Category = 0; Category < Residency.NumCategories(); ++Category)
+    {
+        Ar.Logf(TEXT("%-12s %14.2f %10.2f %10.2f %8d %9d %10lld"), *GetStreamingCategoryName(Category).ToString(),
+            Residency.GetResidentBytes(Category) / (1024.0 * 1024.0), Residency.GetPeakResidentBytes(Category) / (1024.0 * 1024.0),
+            Residency.GetBudget(Category) / (1024.0 * 1024.0), Residency.GetResidentCount(Category), Residency.GetReleasedCount(Category),
+            Residency.GetEvictionCount(Category));
+    }
+
+    Ar.Logf(TEXT("Loaded %.1f KB/s, %.2f MB total (estimated), unload delay hits %lld, unloads expired %lld"),
+        Telemetry.GetBytesPerSecond() / 1024.0, Telemetry.GetTotalBytesLoaded() / (1024.0 * 1024.0),
+        Telemetry.GetUnloadDelayHits(), Telemetry.GetUnloadsExpired());
+}
@@ -0,0 +1,98 @@
+#include "AssetStreamingTelemetry.h"
+
+void FAssetStreamingLatencyHistogram::Add(const double Seconds)
+{
+    int32 Bucket = 0;
+    if (Seconds > MinSeconds)
+    {
+        Bucket = FMath::Min(1 + FMath::FloorToInt32(FMath::Log2(Seconds / MinSeconds) * BucketsPerOctave), BucketCount - 1);
+    }
+
+    ++Buckets[Bucket];
+    ++Count;
+    MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+}
+
+double FAssetStreamingLatencyHistogram::GetPercentile(const double Percentile) const
+{
+    if (Count == 0)
+    {
+        return 0.0;
+    }
+
+    const int64 Target = FMath::Clamp<int64>(FMath::CeilToInt64(FMath::Clamp(Percentile, 0.0, 1.0) * Count), 1, Count);
+    int64 Accumulated = 0;
+    for (int32 Bucket = 0; Bucket < BucketCount; ++Bucket)
+    {
+        Accumulated += Buckets[Bucket];
+        if (Accumulated >= Target)
+        {
+            // Never report more than the slowest sample, the last bucket is open ended
+            return FMath::Min(GetBucketUpperBound(Bucket), MaxSeconds);
+        }
+    }
+    return MaxSeconds;
+}
+
+void FAssetStreamingLatencyHistogram::Reset()
+{
+    FMemory::Memzero(Buckets);
+    Count = 0;
+    MaxSeconds = 0.0;
+}
+
+double FAssetStreamingLatencyHistogram::GetBucketUpperBound(const int32 Bucket)
+{
+    if (Bucket >= BucketCount - 1)
+    {
+        return TNumericLimits<double>::Max();
+    }
+    return MinSeconds * FMath::Pow(2.0, static_cast<double>(Bucket) / BucketsPerOctave);
+}
+
+FAssetStreamingTelemetry::FAssetStreamingTelemetry(const int32 InQueueCount)
+{
+    QueueLatency.SetNum(FMath::Max(InQueueCount, 1));
+}
+
+void FAssetStreamingTelemetry::RecordLoaded(const int32 QueueIndex, const double LatencySeconds)
+{
+    if (QueueLatency.IsValidIndex(QueueIndex))
+    {
+        QueueLatency[QueueIndex].Add(LatencySeconds);
+    }
+    TotalLatency.Add(LatencySeconds);
+}
+
+void FAssetStreamingTelemetry::RecordBytesLoaded(const int64 Bytes)
+{
+    WindowBytes += Bytes;
+    TotalBytesLoaded += Bytes;
+}
+
+void FAssetStreamingTelemetry::Tick(const float DeltaTime)
+{
+    WindowSeconds += DeltaTime;
+    if (WindowSeconds >= 1.f)
+    {
+        BytesPerSecond = WindowBytes / WindowSeconds;
+        WindowBytes = 0;
+        WindowSeconds = 0.f;
+    }
+}
+
+void FAssetStreamingTelemetry::Reset()
+{
+    for (FAssetStreamingLatencyHistogram& Histogram : QueueLatency)
+    {
+        Histogram.Reset();
+    }
+    TotalLatency.Reset();
+
+    WindowBytes = 0;
+    WindowSeconds = 0.f;
+    BytesPerSecond = 0.0;
+    TotalBytesLoaded = 0;
+    UnloadDelayHits = 0;
+    UnloadsExpired = 0;
+}
@@ -0,0 +1,176 @@
+#include "AssetStreamingUnloadTimerWheel.h"
+
+FAssetUnloadTimerWheel::FAssetUnloadTimerWheel(float InTickSeconds)
+    : TickSeconds(FMath::Max(InTickSeconds, UE_KINDA_SMALL_NUMBER))
+{
+    for (int32& Head : SlotHeads)
+    {
+        Head = INDEX_NONE;
+    }
+}
+
+void FAssetUnloadTimerWheel::Schedule(const FSoftObjectPath& Path, float DelaySeconds)
+{
+    const uint64 DelayTicks = FMath::Clamp<uint64>(FMath::CeilToInt64(DelaySeconds / TickSeconds), 1, MaxDelayTicks);
+
+    int32 NodeIndex = INDEX_NONE;
+    if (const int32* Found = NodeLookup.Find(Path))
+    {
+        NodeIndex = *Found;
+        Unlink(NodeIndex);
+    }
+    else
+    {
+        NodeIndex = FreeNodes.Num() > 0 ? FreeNodes.Pop(EAllowShrinking::No) : Nodes.AddDefaulted();
+        Nodes[NodeIndex].Path = Path;
+        NodeLookup.Add(Path, NodeIndex);
+    }
+
+    Nodes[NodeIndex].ExpireTick = CurrentTick + DelayTicks;
+    Link(NodeIndex);
+}
+
+bool FAssetUnloadTimerWheel::Cancel(const FSoftObjectPath& Path)
+{
+    int32 NodeIndex = INDEX_NONE;
+    if (!NodeLookup.RemoveAndCopyValue(Path, NodeIndex))
+    {
+        return false;
+    }
+
+    Unlink(NodeIndex);
+    FreeNode(NodeIndex);
+    return true;
+}
+
+void FAssetUnloadTimerWheel::Advance(float DeltaTime, TArray<FSoftObjectPath>& OutExpired)
+{
+    AccumulatedSeconds += DeltaTime;
+    const uint64 Ticks = static_cast<uint64>(AccumulatedSeconds / TickSeconds);
+    if (Ticks == 0)
+    {
+        return;
+    }
+    AccumulatedSeconds -= Ticks * TickSeconds;
+
+    if (NodeLookup.Num() == 0)
+    {
+        CurrentTick += Ticks;
+        return;
+    }
+
+    for (uint64 Tick = 0; Tick < Ticks && NodeLookup.Num() > 0; ++Tick)
+    {
+        Step(OutExpired);
+    }
+}
+
+void FAssetUnloadTimerWheel::Empty()
+{
+    Nodes.Empty();
+    FreeNodes.Empty();
+    NodeLookup.Empty();
+    for (int32& Head : SlotHeads)
+    {
+        Head = INDEX_NONE;
+    }
+    AccumulatedSeconds = 0.f;
+}
+
+void FAssetUnloadTimerWheel::Link(const int32 NodeIndex)
+{
+    FTimerNode& Node = Nodes[NodeIndex];
+    const uint64 Delta = Node.ExpireTick > CurrentTick ? Node.ExpireTick - CurrentTick : 0;
+
+    // Pick the finest level whose range still covers the delay, coarser slots cascade down as time passes
+    int32 Level = 0;
+    while (Level < LevelCount - 1 && Delta >= (1ull << (SlotBits * (Level + 1))))
+    {
+        ++Level;
+    }
+    const int32 Slot = Level * SlotCount + static_cast<int32>((Node.ExpireTick >> (SlotBits * Level)) & SlotMask);
+
+    Node.Slot = Slot;
+    Node.Prev = INDEX_NONE;
+    Node.Next = SlotHeads[Slot];
+    if (Node.Next != INDEX_NONE)
+    {
+        Nodes[Node.Next].Prev = NodeIndex;
+    }
+    SlotHeads[Slot] = NodeIndex;
+}
+
+void FAssetUnloadTimerWheel::Unlink(const int32 NodeIndex)
+{
+    FTimerNode& Node = Nodes[NodeIndex];
+    if (Node.Slot == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (Node.Prev != INDEX_NONE)
+    {
+        Nodes[Node.Prev].Next = Node.Next;
+    }
+    else
+    {
+        SlotHeads[Node.Slot] = Node.Next;
+    }
+    if (Node.Next != INDEX_NONE)
+    {
+        Nodes[Node.Next].Prev = Node.Prev;
+    }
+
+    Node.Prev = INDEX_NONE;
+    Node.Next = INDEX_NONE;
+    Node.Slot = INDEX_NONE;
+}
+
+void FAssetUnloadTimerWheel::FreeNode(const int32 NodeIndex)
+{
+    Nodes[NodeIndex].Path.Reset();
+    FreeNodes.Add(NodeIndex);
+}
+
+void FAssetUnloadTimerWheel::Cascade(const int32 Level)
+{
+    const int32 Slot = Level * SlotCount + static_cast<int32>((CurrentTick >> (SlotBits * Level)) & SlotMask);
+
+    int32 NodeIndex = SlotHeads[Slot];
+    SlotHeads[Slot] = INDEX_NONE;
+    while (NodeIndex != INDEX_NONE)
+    {
+        const int32 Next = Nodes[NodeIndex].Next;
+        Nodes[NodeIndex].Slot = INDEX_NONE;
+        Link(NodeIndex);
+        NodeIndex = Next;
+    }
+}
+
+void FAssetUnloadTimerWheel::Step(TArray<FSoftObjectPath>& OutExpired)
+{
+    ++CurrentTick;
+
+    // Entering a new level 0 round pulls the due slot of level 1 down, and so on upwards
+    for (int32 Level = 1; Level < LevelCount; ++Level)
+    {
+        if ((CurrentTick & ((1ull << (SlotBits * Level)) - 1)) != 0)
+        {
+            break;
+        }
+        Cascade(Level);
+    }
+
+    const int32 Slot = static_cast<int32>(CurrentTick & SlotMask);
+    int32 NodeIndex = SlotHeads[Slot];
+    SlotHeads[Slot] = INDEX_NONE;
+    while (NodeIndex != INDEX_NONE)
+    {
+        const int32 Next = Nodes[NodeIndex].Next;
+        OutExpired.Add(Nodes[NodeIndex].Path);
+        NodeLookup.Remove(Nodes[NodeIndex].Path);
+        Nodes[NodeIndex].Slot = INDEX_NONE;
+        FreeNode(NodeIndex);
+        NodeIndex = Next;
+    }
+}
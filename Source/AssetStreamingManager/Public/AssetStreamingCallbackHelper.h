@@ -13,9 +13,17 @@ public:
     DECLARE_DELEGATE_TwoParams(FOnAssetLoadedDelegate, const TSoftObjectPtr<UObject>&, bool);
 
     void SetCallback(FOnAssetLoadedDelegate InDelegate);
+    void ResetCallback() { CallbackDelegate.Unbind(); }
 
     virtual void OnAssetLoaded_Implementation(const TSoftObjectPtr<UObject>& Asset, bool bAlreadyLoaded) override;
 
+    // Index in UAssetStreamingSubsystem::CallbackWrappers, INDEX_NONE if not pooled
+    int32 PoolIndex = INDEX_NONE;
+    // Requests still holding this wrapper, it goes back to the pool when this drops to 0
+    int32 UseCount = 0;
+    // Set while PoolIndex is in UAssetStreamingSubsystem::FreeCallbackWrappers
+    bool bInFreeList = false;
+
 private:
     FOnAssetLoadedDelegate CallbackDelegate;
 };
@@ -23,7 +31,11 @@ private:
 class FStreamingCallbackHelper
 {
 public:
+    /**
+     * Returns a pooled wrapper owned by UAssetStreamingSubsystem.
+     * Pass it to a RequestAsset(s)StreamingWithCallback call, it goes back to the pool once that request completes or is released.
+     * A wrapper no request took by the next subsystem tick goes back to the pool as well, do not keep it around.
+     */
     ASSETSTREAMINGMANAGER_API static TScriptInterface<IAssetStreamingCallback> MakeCallback(
-        UObject* Outer,
         UAssetStreamingCallbackWrapper::FOnAssetLoadedDelegate Delegate);
 };
\ No newline at end of file
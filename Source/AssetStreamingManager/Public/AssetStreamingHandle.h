@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "Engine/StreamableManager.h"
+#include "Async/Future.h"
+#include "Async/TaskGraphInterfaces.h"
 #include "AssetStreamingHandle.generated.h"
 
 
@@ -31,13 +33,149 @@ public:
 	TSharedPtr<FStreamableHandle> Handle;
 };
 
+DECLARE_DELEGATE_TwoParams(FOnAssetRequestCompleted, const FSoftObjectPath& /*AssetPath*/, bool /*bAlreadyLoaded*/);
+
+/**
+ * Request handle, index into UAssetStreamingSubsystem's request slot array plus the generation of that slot.
+ * Freeing a slot bumps its generation, so a handle kept after release can never resolve to a reused slot.
+ */
+struct FAssetRequestHandle
+{
+	uint32 Index;
+	uint32 Generation; // 0 is never used by a live slot
+
+	FAssetRequestHandle()
+		: Index(0), Generation(0) {
+	}
+
+	FAssetRequestHandle(uint32 InIndex, uint32 InGeneration)
+		: Index(InIndex), Generation(InGeneration) {
+	}
+
+	FORCEINLINE bool IsValid() const { return Generation != 0; }
+	FORCEINLINE void Invalidate() { Index = 0; Generation = 0; }
+	FORCEINLINE uint64 ToPackedId() const { return (static_cast<uint64>(Generation) << 32) | Index; }
+
+	FORCEINLINE bool operator==(const FAssetRequestHandle& RHS) const
+	{
+		return Index == RHS.Index && Generation == RHS.Generation;
+	}
+
+	friend FORCEINLINE uint32 GetTypeHash(const FAssetRequestHandle& Handle)
+	{
+		return GetTypeHash(Handle.ToPackedId());
+	}
+};
+
+enum class EAssetRequestState : uint8
+{
+	Free,
+	Pending,   // Waiting in DefaultQueue/PriorityQueues
+	Streaming, // Handed to the StreamableManager
+};
+
+/** How much I/O background streaming may keep in flight, see UAssetStreamingSubsystem::SetStreamingMode */
+UENUM(BlueprintType)
+enum class EAssetStreamingMode : uint8
+{
+	Background, // Yield I/O and decompression to gameplay critical loads, e.g. during combat
+	Normal,
+	Burst,      // No in-flight limits and more loads per tick, e.g. behind a loading screen
+};
+
+/** Priority 0 is Background, priorities at or above StreamingManager.CriticalPriority are Critical */
+UENUM(BlueprintType)
+enum class EAssetStreamingPriorityClass : uint8
+{
+	Background,
+	Normal,
+	Critical,
+};
+
+/** In-flight limits of one priority class, 0 is unlimited. A class with nothing in flight always issues its next request. */
+struct FAssetStreamingBudget
+{
+	int64 MaxInFlightBytes = 0;
+	int32 MaxInFlightRequests = 0;
+};
+
+/** Request slot, lives in UAssetStreamingSubsystem::Requests and is addressed by FAssetRequestHandle. */
 struct FAssetRequest
 {
 	FSoftObjectPath AssetPath;
-	FGuid RequestId;
+	TSharedPtr<FStreamableHandle> Handle;
 	int32 Priority; // 0: default queue, 0 ʰ: priority queue
+	uint32 Serial; // Matches the live FAssetQueueEntry, stale entries are skipped on pop
+	uint32 Generation;
+	EAssetRequestState State;
+	FGuid BlueprintId; // Only set for requests made through the Blueprint API
+	FOnAssetRequestCompleted OnCompleted;
+	ENamedThreads::Type CompletionThread;
+	TAsyncLoadPriority AsyncLoadPriority; // Priority the current Handle was issued with
+	TWeakObjectPtr<UObject> CallbackObject; // Implements IAssetStreamingCallback, called once for this request only
+	double RequestTime; // FPlatformTime::Seconds() of the request, 0 once its latency was recorded
+	int64 EstimatedBytes; // Package size from the asset registry, 0 if already loaded or unknown
+	bool bInFlight; // Issued to the async loader and not completed yet
+	EAssetStreamingPriorityClass InFlightClass; // Class charged with GovernorBytes while bInFlight
+	int64 GovernorBytes; // EstimatedBytes, or StreamingManager.UnknownAssetSizeKB when the size is unknown
+	FVector Location; // Spatial requests only, Priority is recomputed from the distance to the nearest streaming source
+	int32 BasePriority; // Priority at distance 0
+	int32 SpatialIndex; // Index in UAssetStreamingSubsystem::SpatialRequests, INDEX_NONE for plain requests
+	bool bIgnoreZ;
+	TSharedPtr<TPromise<UObject*>> UrgentPromise; // LoadAssetUrgent only, fulfilled on load or with nullptr when freed first
+
+	FAssetRequest()
+		: Priority(0), Serial(0), Generation(1), State(EAssetRequestState::Free), CompletionThread(ENamedThreads::GameThread), AsyncLoadPriority(0)
+		, RequestTime(0.0), EstimatedBytes(0), bInFlight(false), InFlightClass(EAssetStreamingPriorityClass::Background), GovernorBytes(0)
+		, Location(FVector::ZeroVector), BasePriority(0), SpatialIndex(INDEX_NONE), bIgnoreZ(false) {
+	}
+};
+
+/** Ticket returned by the thread-safe submission API, resolved to a FAssetRequestHandle when the command is drained. 0 is invalid. */
+typedef uint64 FAssetRequestTicket;
+
+enum class EAssetStreamingCommandType : uint8
+{
+	Request,
+	Release,
+};
+
+/** Command pushed from any thread into UAssetStreamingSubsystem's MPSC submission queue, executed on the next Tick. */
+struct FAssetStreamingCommand
+{
+	EAssetStreamingCommandType Type;
+	FAssetRequestTicket Ticket;
+	FSoftObjectPath AssetPath;
+	int32 Priority;
+	FOnAssetRequestCompleted OnCompleted;
+	ENamedThreads::Type CompletionThread;
+
+	FAssetStreamingCommand()
+		: Type(EAssetStreamingCommandType::Request), Ticket(0), Priority(0), CompletionThread(ENamedThreads::GameThread) {
+	}
+};
+
+/**
+ * Heap node for the pending request queues.
+ * Reprioritize/cancel never search the heap, they only bump or drop the Serial of the request slot,
+ * so an entry whose Serial no longer matches is stale and gets discarded when it reaches the top.
+ */
+struct FAssetQueueEntry
+{
+	uint32 SlotIndex;
+	int32 Priority;
+	uint32 Serial;
+
+	FAssetQueueEntry(uint32 InSlotIndex, int32 InPriority, uint32 InSerial)
+		: SlotIndex(InSlotIndex), Priority(InPriority), Serial(InSerial) {
+	}
+};
 
-	FAssetRequest(const FSoftObjectPath& InPath, const FGuid& InId, int32 InPriority = -1)
-		: AssetPath(InPath), RequestId(InId), Priority(InPriority) {
+/** Higher priority first, FIFO (lower serial) among equal priorities. */
+struct FAssetQueueEntryPredicate
+{
+	FORCEINLINE bool operator()(const FAssetQueueEntry& A, const FAssetQueueEntry& B) const
+	{
+		return A.Priority != B.Priority ? A.Priority > B.Priority : A.Serial < B.Serial;
 	}
 };
\ No newline at end of file
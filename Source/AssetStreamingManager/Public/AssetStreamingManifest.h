@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+struct FAssetPreloadManifestEntry
+{
+    FSoftObjectPath AssetPath;
+    // Seconds since the map finished loading when the asset was first requested
+    float TimeSeconds = 0.f;
+    // Player progress at that time, see UAssetStreamingSubsystem::SetPreloadProgress. Replay is keyed off this value
+    float Progress = 0.f;
+};
+
+/**
+ * Ordered list of the assets requested during one playthrough of a map and route.
+ * Saved as a small zlib compressed binary file under Saved/AssetStreaming/Manifests.
+ */
+class ASSETSTREAMINGMANAGER_API FAssetPreloadManifest
+{
+public:
+    FName MapName;
+    FName Route;
+    TArray<FAssetPreloadManifestEntry> Entries;
+
+    bool Save(const FString& Filename);
+    bool Load(const FString& Filename);
+    void Reset();
+
+    static FString GetManifestPath(const FName MapName, const FName Route);
+    /** Captured warm set of a map, the assets its first seconds of gameplay requested */
+    static FString GetWarmSetPath(const FName MapName);
+
+private:
+    void Serialize(FArchive& Ar);
+};
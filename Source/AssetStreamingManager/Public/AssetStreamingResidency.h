@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+/**
+ * Resident bytes per asset category and one LRU list of released assets per category.
+ * Every asset held in UAssetStreamingSubsystem::KeepAlive is tracked, only released assets
+ * waiting for their unload delay are eviction candidates. Add/Remove/Touch are O(1).
+ * Bytes start as an estimate and are replaced by the loaded asset's memory size once it is measured.
+ */
+class ASSETSTREAMINGMANAGER_API FAssetStreamingResidency
+{
+public:
+    explicit FAssetStreamingResidency(const int32 InCategoryCount = 1);
+
+    /** Drops every tracked asset and resizes, budgets are reset to unlimited */
+    void SetCategoryCount(const int32 InCategoryCount);
+    /** 0 is unlimited */
+    void SetBudget(const int32 Category, const int64 BudgetBytes);
+    int64 GetBudget(const int32 Category) const { return Categories[Category].BudgetBytes; }
+
+    void Add(const FSoftObjectPath& Path, const int32 Category, const int64 Bytes);
+    void Remove(const FSoftObjectPath& Path);
+    bool Contains(const FSoftObjectPath& Path) const { return NodeLookup.Contains(Path); }
+
+    /** Replaces the estimate the asset was added with, returns false when it is not tracked */
+    bool SetMeasuredBytes(const FSoftObjectPath& Path, const int64 Bytes);
+    bool IsMeasured(const FSoftObjectPath& Path) const;
+
+    /** No longer requested, becomes the most recently used eviction candidate of its category */
+    void MarkReleased(const FSoftObjectPath& Path);
+    /** Requested again, no longer an eviction candidate */
+    void MarkRequested(const FSoftObjectPath& Path);
+
+    /** Appends the least recently released assets of every category over its budget, enough to bring it back under */
+    void GatherEvictions(TArray<FSoftObjectPath>& OutEvicted) const;
+    void RecordEvicted(const FSoftObjectPath& Path);
+
+    int32 NumCategories() const { return Categories.Num(); }
+    int64 GetResidentBytes(const int32 Category) const { return Categories[Category].ResidentBytes; }
+    int64 GetPeakResidentBytes(const int32 Category) const { return Categories[Category].PeakResidentBytes; }
+    int32 GetResidentCount(const int32 Category) const { return Categories[Category].ResidentCount; }
+    int32 GetReleasedCount(const int32 Category) const { return Categories[Category].ReleasedCount; }
+    int64 GetEvictionCount(const int32 Category) const { return Categories[Category].EvictionCount; }
+    void ResetPeaks();
+
+    SIZE_T GetAllocatedSize() const { return Nodes.GetAllocatedSize() + FreeNodes.GetAllocatedSize() + NodeLookup.GetAllocatedSize() + Categories.GetAllocatedSize(); }
+    void Empty();
+
+private:
+    struct FResidentNode
+    {
+        FSoftObjectPath Path;
+        int64 Bytes = 0;
+        int32 Category = 0;
+        bool bMeasured = false;
+        // Intrusive LRU links, only while released
+        int32 Prev = INDEX_NONE;
+        int32 Next = INDEX_NONE;
+        bool bReleased = false;
+    };
+
+    struct FCategory
+    {
+        int64 BudgetBytes = 0;
+        int64 ResidentBytes = 0;
+        int64 PeakResidentBytes = 0;
+        int32 ResidentCount = 0;
+        int32 ReleasedCount = 0;
+        int64 EvictionCount = 0;
+        // Least recently released first
+        int32 LruHead = INDEX_NONE;
+        int32 LruTail = INDEX_NONE;
+    };
+
+    void Link(const int32 NodeIndex);
+    void Unlink(const int32 NodeIndex);
+
+    TArray<FResidentNode> Nodes;
+    TArray<int32> FreeNodes;
+    TMap<FSoftObjectPath, int32> NodeLookup;
+    TArray<FCategory> Categories;
+};
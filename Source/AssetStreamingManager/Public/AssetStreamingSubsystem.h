@@ -1,18 +1,70 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Queue.h"
 #include "Engine/StreamableManager.h"
 #include "Tickable.h"
 
+#include <atomic>
+
 #include "AssetStreamingCallback.h"
+#include "AssetStreamingCallbackHelper.h"
 #include "AssetStreamingHandle.h"
+#include "AssetStreamingManifest.h"
+#include "AssetStreamingResidency.h"
+#include "AssetStreamingTelemetry.h"
+#include "AssetStreamingUnloadTimerWheel.h"
 #include "AssetStreamingSubsystem.generated.h"
 
 typedef TArray<TSharedRef<FStreamableHandle>> FStreamableHandleArray;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAssetLoadedBP, UObject*, LoadedAsset, bool, bAlreadyLoaded);
 
-UCLASS()
+/** Assets bulk-loaded behind the loading screen of a map, see UAssetStreamingSubsystem::BeginWarmSet */
+USTRUCT()
+struct FAssetWarmSet
+{
+    GENERATED_BODY()
+
+    // Short package name of the map
+    UPROPERTY()
+    FName MapName;
+
+    UPROPERTY()
+    TArray<FSoftObjectPath> Assets;
+};
+
+/**
+ * Resident memory budget for a group of assets, matched by the "AssetStreamingCategory" asset registry tag first and the asset class second.
+ * Assets matching no category go to "Other".
+ */
+USTRUCT()
+struct FAssetStreamingCategory
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FName Name;
+
+    UPROPERTY()
+    TArray<FTopLevelAssetPath> AssetClasses;
+
+    // Released assets of the category are unloaded early, least recently released first, while it is over budget. 0 is unlimited
+    UPROPERTY()
+    int32 BudgetMB = 0;
+};
+
+/** Public objects of a prefetched dependency package. A UPackage does not reference its inners, holding it alone does not keep them from GC */
+USTRUCT()
+struct FAssetPrefetchedPackage
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<TObjectPtr<UObject>> Objects;
+};
+
+UCLASS(Config = Game, MinimalAPI)
 class UAssetStreamingSubsystem : public UEngineSubsystem, public FTickableGameObject
 {
     GENERATED_BODY()
@@ -22,17 +74,118 @@ public:
 protected:
     FStreamableManager StreamableManager;
 
-    TMap<FGuid, FAssetHandleStruct> RegisteredAssets;
+    // Request slots addressed by FAssetRequestHandle, freed slots are recycled through FreeRequestSlots
+    TArray<FAssetRequest> Requests;
+    TArray<uint32> FreeRequestSlots;
+    // Thin FGuid mapping kept only for the Blueprint API
+    TMap<FGuid, FAssetRequestHandle> BlueprintRequestIds;
+
+    // Lock-free submission from any thread, drained at the start of Tick
+    TQueue<FAssetStreamingCommand, EQueueMode::Mpsc> SubmittedCommands;
+    std::atomic<FAssetRequestTicket> NextSubmissionTicket{ 1 };
+    TMap<FAssetRequestTicket, FAssetRequestHandle> SubmittedRequests;
+
+    // Flattened hard package dependencies per requested package, see StreamingManager.bPrefetchDependencies
+    TMap<FName, TArray<FName>> DependencyCache;
+    int32 DependencyCacheDepth = 0;
+    // Dependency packages currently being prefetched and the async priority they were issued with
+    TMap<FName, TAsyncLoadPriority> InFlightPrefetches;
+    // Prefetched dependencies per requested asset, held until that asset has loaded so GC cannot drop them before it imports them
+    TMap<FSoftObjectPath, TArray<FName>> PrefetchOwners;
+    TMap<FName, int32> PrefetchRefCounts;
+    UPROPERTY(Transient)
+    TMap<FName, FAssetPrefetchedPackage> HeldPrefetches;
+
+    // Every wrapper handed out by FStreamingCallbackHelper, kept alive here instead of being rooted
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UAssetStreamingCallbackWrapper>> CallbackWrappers;
+    TArray<int32> FreeCallbackWrappers;
+    // Handed out since the last tick, the ones no request took go back to the pool
+    TArray<int32> UnclaimedCallbackWrappers;
+
     TMap<FSoftObjectPath, int32> AssetRequestCount;
     TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> KeepAlive;
-    TMap<FSoftObjectPath, float> UnloadTimers;
+    FAssetUnloadTimerWheel UnloadTimers;
+
+    // Categories configured in DefaultGame.ini, the defaults from Initialize otherwise. Residency has one more for "Other"
+    UPROPERTY(Config)
+    TArray<FAssetStreamingCategory> StreamingCategories;
+    // Estimated bytes of every KeepAlive asset per category, with the LRU of released assets
+    FAssetStreamingResidency Residency;
 
 
     static constexpr int32 PriorityGroupCount = 11;
+    // Above any priority a caller can give, always the top of the highest priority group
+    static constexpr int32 UrgentPriority = MAX_int32;
 
-    TArray<FAssetRequest> DefaultQueue;
-    TArray<FAssetRequest> PriorityQueues[PriorityGroupCount];
+    // The queues are heaps of FAssetQueueEntry pointing at Pending request slots
+    TArray<FAssetQueueEntry> DefaultQueue;
+    TArray<FAssetQueueEntry> PriorityQueues[PriorityGroupCount];
     int32 MaxPriorityQueueSize = 8;
+    // Live entries per queue, index 0 is DefaultQueue and 1 + group the priority queues, see GetQueueIndex
+    int32 QueueDepths[PriorityGroupCount + 1] = {};
+    int32 InFlightRequestCount = 0;
+    int32 StaleQueueEntryCount = 0;
+    uint32 NextQueueSerial = 0;
+
+    // I/O governor, in-flight requests and estimated bytes per EAssetStreamingPriorityClass
+    static constexpr int32 StreamingModeCount = 3;
+    static constexpr int32 PriorityClassCount = 3;
+    EAssetStreamingMode StreamingMode = EAssetStreamingMode::Normal;
+    FAssetStreamingBudget StreamingBudgets[StreamingModeCount][PriorityClassCount] =
+    {
+        { { 2 * 1024 * 1024, 2 }, { 8 * 1024 * 1024, 4 }, {} },    // Background
+        { { 16 * 1024 * 1024, 8 }, { 64 * 1024 * 1024, 32 }, {} }, // Normal
+        { {}, {}, {} },                                              // Burst
+    };
+    int64 InFlightBytes[PriorityClassCount] = {};
+    int32 InFlightRequests[PriorityClassCount] = {};
+
+    // Pending and in-flight requests tied to a location, re-evaluated round-robin from SpatialCursor
+    TArray<uint32> SpatialRequests;
+    int32 SpatialCursor = 0;
+    // Set through SetStreamingSources, otherwise gathered from local player view points every tick
+    TArray<FVector> StreamingSources;
+    bool bExplicitStreamingSources = false;
+
+    // Preload manifests of the current map, see StreamingManager.Preload.* cvars
+    FName PreloadMapName;
+    FName PreloadRoute;
+    float PreloadTimeSeconds = 0.f;
+    float PreloadProgress = 0.f;
+    bool bExternalPreloadProgress = false;
+    FAssetPreloadManifest RecordingManifest;
+    TSet<FSoftObjectPath> RecordedAssets;
+    FAssetPreloadManifest ReplayManifest;
+    // Parallel to ReplayManifest.Entries, entries are issued and released in order as progress moves on
+    TArray<FAssetRequestHandle> ReplayRequests;
+    int32 ReplayIssueCursor = 0;
+    int32 ReplayReleaseCursor = 0;
+    // Set while the subsystem issues its own replay and warm set requests, these are not recorded
+    bool bIssuingReplay = false;
+
+    // Authored per map under [/Script/AssetStreamingManager.AssetStreamingSubsystem] in DefaultGame.ini, loaded along with the captured warm set
+    UPROPERTY(Config)
+    TArray<FAssetWarmSet> AuthoredWarmSets;
+    // Requests of the current warm set, released StreamingManager.WarmSet.RetainSeconds after it completed
+    TArray<FAssetRequestHandle> WarmSetRequests;
+    // Atomic, loading screens poll the progress from the loading thread while the game thread is inside LoadMap
+    std::atomic<int32> WarmSetLoadedCount{ 0 };
+    std::atomic<int32> WarmSetTotalCount{ 0 };
+    std::atomic<bool> bLoadingWarmSet{ false };
+    float WarmSetRetainTime = 0.f;
+    EAssetStreamingMode WarmSetPreviousMode = EAssetStreamingMode::Normal;
+    // First requests of the current map, saved as its warm set when the map unloads
+    FAssetPreloadManifest WarmSetCapture;
+    TSet<FSoftObjectPath> WarmSetCapturedAssets;
+    FDelegateHandle PreLoadMapHandle;
+    FDelegateHandle PostLoadMapHandle;
+
+    // Package DiskSize from the asset registry, used for the bytes loaded estimate and as the resident size until the asset is measured
+    TMap<FName, int64> PackageSizeCache;
+    // CSV stat names of each residency category, rebuilt when the categories are loaded
+    TArray<TPair<FName, FName>> ResidencyStatNames;
+    FAssetStreamingTelemetry Telemetry{ PriorityGroupCount + 1 };
 
 public:
     UPROPERTY(BlueprintAssignable, Category = "Asset Streaming Events")
@@ -49,32 +202,201 @@ public:
     ASSETSTREAMINGMANAGER_API virtual bool IsTickable() const override { return true; }
 
     ASSETSTREAMINGMANAGER_API virtual int32 GetPriorityGroup(const int32 Priority);
+    // Maps a request Priority onto the engine async loader priority, see StreamingManager.AsyncLoadPriority* cvars
+    ASSETSTREAMINGMANAGER_API virtual TAsyncLoadPriority GetAsyncLoadPriority(const int32 Priority) const;
+    ASSETSTREAMINGMANAGER_API EAssetStreamingPriorityClass GetPriorityClass(const int32 Priority) const;
+
+    /** Switches the in-flight budgets, Background during combat, Burst behind loading screens */
+    UFUNCTION(BlueprintCallable, Category = "Asset Streaming Functions")
+    ASSETSTREAMINGMANAGER_API void SetStreamingMode(EAssetStreamingMode Mode);
+    UFUNCTION(BlueprintPure, Category = "Asset Streaming Functions")
+    ASSETSTREAMINGMANAGER_API EAssetStreamingMode GetStreamingMode() const { return StreamingMode; }
+
+    ASSETSTREAMINGMANAGER_API void SetStreamingBudget(EAssetStreamingMode Mode, EAssetStreamingPriorityClass PriorityClass, const FAssetStreamingBudget& Budget);
+    ASSETSTREAMINGMANAGER_API const FAssetStreamingBudget& GetStreamingBudget(EAssetStreamingMode Mode, EAssetStreamingPriorityClass PriorityClass) const;
+
+    ASSETSTREAMINGMANAGER_API bool RequestAssetStreaming(const FSoftObjectPath& AssetPath, FAssetRequestHandle& OutRequestHandle, const int32& Priority = 0);
+    // One handle per path, in order. Returns false when any request was dropped, its handle is invalid
+    ASSETSTREAMINGMANAGER_API bool RequestAssetsStreaming(const TArray<FSoftObjectPath>& AssetPaths, TArray<FAssetRequestHandle>& OutRequestHandles, const int32& Priority = 0);
+
+    // Callback is invoked on the game thread for these requests only, instead of going through OnAssetLoaded
+    ASSETSTREAMINGMANAGER_API bool RequestAssetStreamingWithCallback(const FSoftObjectPath& AssetPath, FAssetRequestHandle& OutRequestHandle, const TScriptInterface<IAssetStreamingCallback>& Callback, const int32& Priority = 0);
+    ASSETSTREAMINGMANAGER_API bool RequestAssetsStreamingWithCallback(const TArray<FSoftObjectPath>& AssetPaths, TArray<FAssetRequestHandle>& OutRequestHandles, const TScriptInterface<IAssetStreamingCallback>& Callback, const int32& Priority = 0);
+    ASSETSTREAMINGMANAGER_API bool RequestAssetStreamingWithCallback(const FSoftObjectPath& AssetPath, FAssetRequestHandle& OutRequestHandle, FOnAssetRequestCompleted OnCompleted, const int32& Priority = 0);
+
+    // A wrapper not attached to a request by the next tick goes back to the pool
+    ASSETSTREAMINGMANAGER_API UAssetStreamingCallbackWrapper* AcquireCallbackWrapper();
+
+    /**
+     * Priority is the priority at distance 0. The effective priority falls off with the distance to the nearest
+     * streaming source and is kept up to date incrementally, see StreamingManager.DistancePriority* cvars.
+     */
+    ASSETSTREAMINGMANAGER_API bool RequestAssetStreamingAtLocation(const FSoftObjectPath& AssetPath, FAssetRequestHandle& OutRequestHandle, const FVector& Location, const int32& Priority = 100, const bool bIgnoreZ = false);
+    /** Cell is a FWorldGridStreamMathHelpers::GetGridIndex index, the request is tied to the cell center */
+    ASSETSTREAMINGMANAGER_API bool RequestAssetStreamingAtCell(const FSoftObjectPath& AssetPath, FAssetRequestHandle& OutRequestHandle, const FInt64Vector& Cell, const int32 CellSize, const int32& Priority = 100, const bool b2DGrid = true);
 
-    ASSETSTREAMINGMANAGER_API bool RequestAssetStreaming(const FSoftObjectPath& AssetPath, FGuid& OutRequestId, const int32& Priority = 0);
-    ASSETSTREAMINGMANAGER_API bool RequestAssetsStreaming(const TArray<FSoftObjectPath>& AssetPaths, TArray<FGuid>& OutRequestId, const int32& Priority = 0);
+    /** Overrides the player view points as streaming sources until ClearStreamingSources */
+    UFUNCTION(BlueprintCallable, Category = "Asset Streaming Functions")
+    ASSETSTREAMINGMANAGER_API void SetStreamingSources(const TArray<FVector>& Sources);
+    UFUNCTION(BlueprintCallable, Category = "Asset Streaming Functions")
+    ASSETSTREAMINGMANAGER_API void ClearStreamingSources();
+    ASSETSTREAMINGMANAGER_API virtual int32 GetDistancePriority(const int32 BasePriority, const double Distance) const;
+
+    /** Selects the manifest recorded and replayed for the current map, e.g. a story branch or a spawn point */
+    UFUNCTION(BlueprintCallable, Category = "Asset Streaming Functions")
+    ASSETSTREAMINGMANAGER_API void SetPreloadRoute(FName Route);
+    /** Player progress replay is keyed off. Defaults to seconds since the map loaded until the game sets it */
+    UFUNCTION(BlueprintCallable, Category = "Asset Streaming Functions")
+    ASSETSTREAMINGMANAGER_API void SetPreloadProgress(float Progress);
+    /** Writes what was recorded so far for the current map and route, also done on map change and shutdown */
+    ASSETSTREAMINGMANAGER_API bool SavePreloadRecording();
+
+    /**
+     * Loads the authored and captured warm set of MapName in Burst mode, issued all at once past the queues and the per tick limit.
+     * Done on PreLoadMap, call it directly before a loading screen that does not go through LoadMap. False if the map has no warm set.
+     */
+    ASSETSTREAMINGMANAGER_API bool BeginWarmSet(FName MapName);
+    /** Releases the warm set, assets requested by gameplay in the meantime stay loaded */
+    ASSETSTREAMINGMANAGER_API void EndWarmSet();
+    /** Thread-safe, fraction of the warm set loaded. 1 when no warm set is loading */
+    UFUNCTION(BlueprintPure, Category = "Asset Streaming Functions")
+    ASSETSTREAMINGMANAGER_API float GetWarmSetProgress() const;
+    /** Thread-safe */
+    UFUNCTION(BlueprintPure, Category = "Asset Streaming Functions")
+    ASSETSTREAMINGMANAGER_API bool IsLoadingWarmSet() const { return bLoadingWarmSet; }
 	
 	ASSETSTREAMINGMANAGER_API UObject* LoadAssetSync(const FSoftObjectPath& AssetPath);
 
-    ASSETSTREAMINGMANAGER_API bool ReleaseAsset(FGuid& RequestId);
-	ASSETSTREAMINGMANAGER_API bool ReleaseAssets(const TArray<FGuid>& RequestIds);
+    /**
+     * "Need it now" load. Issues a request at UrgentPriority right away, which also raises the package in the async loader
+     * if it is already in flight, and promotes queued requests for the same asset. Then waits up to TimeoutSeconds for this
+     * package only, without flushing unrelated loads. The future is set on the game thread once loaded, nullptr on failure.
+     * Keep OutRequestHandle until done with the object and release it like any other request.
+     */
+    ASSETSTREAMINGMANAGER_API TFuture<UObject*> LoadAssetUrgent(const FSoftObjectPath& AssetPath, FAssetRequestHandle& OutRequestHandle, const float TimeoutSeconds = 0.f);
+
+    ASSETSTREAMINGMANAGER_API bool ReleaseAsset(FAssetRequestHandle& RequestHandle);
+	ASSETSTREAMINGMANAGER_API bool ReleaseAssets(const TArray<FAssetRequestHandle>& RequestHandles);
+
+    // Queued requests are re-sorted, in-flight requests can only be escalated in the async loader. Only queued requests can be cancelled
+    // Moving a queued request into a full priority group fails and leaves it queued at its old priority
+    ASSETSTREAMINGMANAGER_API bool UpdateRequestPriority(const FAssetRequestHandle& RequestHandle, int32 NewPriority);
+    ASSETSTREAMINGMANAGER_API bool CancelRequest(FAssetRequestHandle& RequestHandle);
+
+    ASSETSTREAMINGMANAGER_API bool IsRequestValid(const FAssetRequestHandle& RequestHandle) const { return ResolveRequest(RequestHandle) != nullptr; }
+    ASSETSTREAMINGMANAGER_API bool IsRequestPending(const FAssetRequestHandle& RequestHandle) const;
+    /** Current effective priority, INDEX_NONE for an invalid handle */
+    ASSETSTREAMINGMANAGER_API int32 GetRequestPriority(const FAssetRequestHandle& RequestHandle) const;
+
+    /**
+     * Thread-safe, can be called from any thread. The request is issued on the next Tick and
+     * OnCompleted is executed on CompletionThread once the asset is loaded.
+     */
+    ASSETSTREAMINGMANAGER_API FAssetRequestTicket SubmitRequest(const FSoftObjectPath& AssetPath, const int32 Priority = 0,
+        FOnAssetRequestCompleted OnCompleted = FOnAssetRequestCompleted(), ENamedThreads::Type CompletionThread = ENamedThreads::GameThread);
+    /** Thread-safe, releases a request made with SubmitRequest on the next Tick */
+    ASSETSTREAMINGMANAGER_API void SubmitRelease(const FAssetRequestTicket Ticket);
+
+    ASSETSTREAMINGMANAGER_API int32 GetPendingRequestCount() const;
+    ASSETSTREAMINGMANAGER_API int32 GetInFlightRequestCount() const { return InFlightRequestCount; }
+    ASSETSTREAMINGMANAGER_API const FAssetStreamingTelemetry& GetTelemetry() const { return Telemetry; }
+    ASSETSTREAMINGMANAGER_API void ResetTelemetry() { Telemetry.Reset(); Residency.ResetPeaks(); }
+    ASSETSTREAMINGMANAGER_API const FAssetStreamingResidency& GetResidency() const { return Residency; }
+
+    /** Category index in GetResidency, the last one is "Other". INDEX_NONE for an unknown name */
+    ASSETSTREAMINGMANAGER_API int32 FindStreamingCategory(const FName CategoryName) const;
+    ASSETSTREAMINGMANAGER_API FName GetStreamingCategoryName(const int32 Category) const;
+    ASSETSTREAMINGMANAGER_API int32 GetAssetStreamingCategory(const FSoftObjectPath& AssetPath) const;
+    /** 0 is unlimited. Only released assets are evicted, requested assets are counted but never unloaded */
+    ASSETSTREAMINGMANAGER_API bool SetStreamingCategoryBudget(const FName CategoryName, const int64 BudgetBytes);
+    /** Logs queue contents, in-flight requests and latency percentiles, see StreamingManager.DumpQueues */
+    ASSETSTREAMINGMANAGER_API void DumpQueues(FOutputDevice& Ar) const;
+    /** Heap memory held by the request slots, queues and bookkeeping maps, excluding loaded assets */
+    ASSETSTREAMINGMANAGER_API SIZE_T GetAllocatedSize() const;
     // Blueprint
 protected:
     UFUNCTION(BlueprintCallable, DisplayName = "Request Assets", Category = "Asset Streaming Functions")
     bool K2_RequestAssetsStreaming(const TArray<FSoftObjectPath>& AssetsToStream, TArray<FGuid>& OutAssetRequestId);
 
     UFUNCTION(BlueprintCallable, DisplayName = "Request Assets w/Callback", Category = "Asset Streaming Functions")
-    bool K2_RequestAssetsStreamingWithCallback(const TArray<FSoftObjectPath>& AssetsToStream, TArray<FGuid>& OutAssetRequestId);
+    bool K2_RequestAssetsStreamingWithCallback(const TArray<FSoftObjectPath>& AssetsToStream, TScriptInterface<IAssetStreamingCallback> Callback, TArray<FGuid>& OutAssetRequestId);
 
     UFUNCTION(BlueprintCallable, DisplayName = "Request Asset Streaming", Category = "Asset Streaming Functions")
     bool K2_RequestAssetStreaming(const FSoftObjectPath& AssetToStream, FGuid& OutAssetRequestId);
 
     UFUNCTION(BlueprintCallable, DisplayName = "Request Asset Streaming w/Callback", Category = "Asset Streaming Functions")
-    bool K2_RequestAssetStreamingWithCallback(const FSoftObjectPath& AssetToStream, FGuid& OutAssetRequestId);
+    bool K2_RequestAssetStreamingWithCallback(const FSoftObjectPath& AssetToStream, TScriptInterface<IAssetStreamingCallback> Callback, FGuid& OutAssetRequestId);
+
+    UFUNCTION(BlueprintCallable, DisplayName = "Request Asset Streaming At Location", Category = "Asset Streaming Functions")
+    bool K2_RequestAssetStreamingAtLocation(const FSoftObjectPath& AssetToStream, const FVector& Location, int32 Priority, FGuid& OutAssetRequestId);
 
     UFUNCTION(BlueprintCallable, DisplayName = "Release Assets", Category = "Asset Streaming Functions")
     bool K2_ReleaseAssets(UPARAM(Ref) FGuid& RequestId);
 
+    UFUNCTION(BlueprintCallable, DisplayName = "Update Request Priority", Category = "Asset Streaming Functions")
+    bool K2_UpdateRequestPriority(const FGuid& RequestId, int32 NewPriority);
+
+    UFUNCTION(BlueprintCallable, DisplayName = "Cancel Request", Category = "Asset Streaming Functions")
+    bool K2_CancelRequest(UPARAM(Ref) FGuid& RequestId);
+
+    // Loader entry points, the benchmark overrides these with a stand-in loader that never touches disk
+    ASSETSTREAMINGMANAGER_API virtual bool IsAssetLoadComplete(const FSoftObjectPath& AssetPath) const;
+    ASSETSTREAMINGMANAGER_API virtual TSharedPtr<FStreamableHandle> RequestAsyncLoad(const FSoftObjectPath& AssetPath, FStreamableDelegate OnLoaded, const TAsyncLoadPriority AsyncLoadPriority);
+
 private:
-    void StreamAsset(const FSoftObjectPath& AssetPath, const FGuid& RequestId);
-    void HandleAssetLoaded(const FSoftObjectPath& AssetPath, bool bAlreadyLoaded);
+    FAssetRequest* ResolveRequest(const FAssetRequestHandle& RequestHandle);
+    const FAssetRequest* ResolveRequest(const FAssetRequestHandle& RequestHandle) const;
+    FAssetRequestHandle AllocateRequest(const FSoftObjectPath& AssetPath, const int32 Priority);
+    void FreeRequest(const uint32 SlotIndex);
+    bool ResolveBlueprintId(const FGuid& RequestId, FAssetRequestHandle& OutRequestHandle) const;
+    FGuid MakeBlueprintId(const FAssetRequestHandle& RequestHandle);
+
+    TArray<FAssetQueueEntry>& GetQueue(const int32 Priority);
+    int32 GetQueueIndex(const int32 Priority);
+    bool EnqueueRequest(const uint32 SlotIndex);
+    bool IsQueueEntryLive(const FAssetQueueEntry& Entry) const;
+    bool PeekQueue(TArray<FAssetQueueEntry>& Queue, uint32& OutSlotIndex);
+    bool PopQueue(TArray<FAssetQueueEntry>& Queue, uint32& OutSlotIndex);
+    bool HasStreamingBudget(const uint32 SlotIndex);
+    void BeginInFlight(FAssetRequest& Request);
+    void EndInFlight(FAssetRequest& Request);
+    void CompactQueues();
+
+    void DrainSubmittedCommands();
+    void TrackSpatialRequest(const uint32 SlotIndex, const FVector& Location, const int32 BasePriority, const bool bIgnoreZ);
+    void UntrackSpatialRequest(FAssetRequest& Request);
+    double GetNearestSourceDistance(const FAssetRequest& Request) const;
+    void GatherStreamingSources();
+    void UpdateDistancePriorities();
+    void SetRequestCallback(const FAssetRequestHandle& RequestHandle, const TScriptInterface<IAssetStreamingCallback>& Callback);
+    void ReleaseRequestCallback(FAssetRequest& Request);
+    void ReleaseCallbackWrapper(UObject* CallbackObject);
+    void ReclaimUnusedCallbackWrappers();
+
+    void OnPreLoadMap(const FString& MapName);
+    void OnPostLoadMap(UWorld* World);
+    void BeginPreloadSession();
+    void EndPreloadSession();
+    void RecordPreloadRequest(const FSoftObjectPath& AssetPath);
+    void UpdatePreloadReplay(float DeltaTime);
+    void OnWarmSetAssetLoaded(const FSoftObjectPath& AssetPath, bool bAlreadyLoaded);
+    void UpdateWarmSet(float DeltaTime);
+    bool SaveWarmSetCapture();
+
+    void StreamAsset(const uint32 SlotIndex);
+    void UnloadAsset(const FSoftObjectPath& AssetPath);
+    void EvictOverBudgetAssets();
+    TSharedPtr<FStreamableHandle> IssueAsyncLoad(const uint32 SlotIndex, const bool bAlreadyLoaded);
+    void EscalateInFlightRequest(const uint32 SlotIndex);
+
+    const TArray<FName>& GetHardDependencies(const FName PackageName);
+    void PrefetchDependencies(const FSoftObjectPath& AssetPath, const TAsyncLoadPriority AsyncLoadPriority);
+    // The asset has loaded or was unloaded, its prefetched dependencies no longer need holding
+    void HoldPrefetch(const FName PackageName, UPackage* Package);
+    void ReleasePrefetches(const FSoftObjectPath& AssetPath);
+    void HandleAssetLoaded(const FAssetRequestHandle RequestHandle, const FSoftObjectPath& AssetPath, bool bAlreadyLoaded);
+
+    int64 GetEstimatedPackageSize(const FName PackageName);
+    void RecordRequestLoaded(FAssetRequest& Request, bool bAlreadyLoaded);
+    void PublishTelemetry(float DeltaTime);
 };
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fixed size latency histogram with quarter octave buckets from 0.25ms up to ~65s.
+ * Add is O(1) and allocation free, percentiles are reported as the upper bound of the bucket they fall in.
+ */
+class ASSETSTREAMINGMANAGER_API FAssetStreamingLatencyHistogram
+{
+public:
+    FAssetStreamingLatencyHistogram() { Reset(); }
+
+    void Add(const double Seconds);
+    /** Percentile in [0, 1], returns seconds or 0 when no sample was recorded */
+    double GetPercentile(const double Percentile) const;
+    int64 Num() const { return Count; }
+    double GetMax() const { return MaxSeconds; }
+    void Reset();
+
+private:
+    static constexpr int32 BucketsPerOctave = 4;
+    static constexpr int32 OctaveCount = 18;
+    static constexpr int32 BucketCount = OctaveCount * BucketsPerOctave + 2;
+    static constexpr double MinSeconds = 0.00025;
+
+    static double GetBucketUpperBound(const int32 Bucket);
+
+    int64 Buckets[BucketCount];
+    int64 Count = 0;
+    double MaxSeconds = 0.0;
+};
+
+/**
+ * Counters behind the AssetStreamingManager stats, CSV and trace output.
+ * Queue index 0 is the default queue, 1 + priority group for the priority queues.
+ */
+class ASSETSTREAMINGMANAGER_API FAssetStreamingTelemetry
+{
+public:
+    explicit FAssetStreamingTelemetry(const int32 InQueueCount);
+
+    /** Request to loaded latency, measured from the request call to the load callback */
+    void RecordLoaded(const int32 QueueIndex, const double LatencySeconds);
+    void RecordBytesLoaded(const int64 Bytes);
+    /** A released asset was requested again before StreamingManager.UnloadDelaySeconds ran out */
+    void RecordUnloadDelayHit() { ++UnloadDelayHits; }
+    void RecordUnloadExpired() { ++UnloadsExpired; }
+
+    /** Rolls the bytes per second window */
+    void Tick(const float DeltaTime);
+    void Reset();
+
+    int32 NumQueues() const { return QueueLatency.Num(); }
+    const FAssetStreamingLatencyHistogram& GetQueueLatency(const int32 QueueIndex) const { return QueueLatency[QueueIndex]; }
+    const FAssetStreamingLatencyHistogram& GetTotalLatency() const { return TotalLatency; }
+    double GetBytesPerSecond() const { return BytesPerSecond; }
+    int64 GetTotalBytesLoaded() const { return TotalBytesLoaded; }
+    int64 GetUnloadDelayHits() const { return UnloadDelayHits; }
+    int64 GetUnloadsExpired() const { return UnloadsExpired; }
+
+private:
+    TArray<FAssetStreamingLatencyHistogram> QueueLatency;
+    FAssetStreamingLatencyHistogram TotalLatency;
+
+    int64 WindowBytes = 0;
+    float WindowSeconds = 0.f;
+    double BytesPerSecond = 0.0;
+    int64 TotalBytesLoaded = 0;
+    int64 UnloadDelayHits = 0;
+    int64 UnloadsExpired = 0;
+};
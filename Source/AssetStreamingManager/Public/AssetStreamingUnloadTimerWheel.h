@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+/**
+ * Hierarchical timer wheel for delayed asset unloads.
+ * Three levels of 64 slots, a level 0 slot covers one tick of TickSeconds.
+ * Schedule/Cancel are O(1) and Advance only touches the slots that come due, so
+ * thousands of released assets waiting to unload cost nothing per frame.
+ */
+class ASSETSTREAMINGMANAGER_API FAssetUnloadTimerWheel
+{
+public:
+    explicit FAssetUnloadTimerWheel(float InTickSeconds = 0.1f);
+
+    /** Schedules Path to expire after DelaySeconds, restarting the timer if it is already scheduled */
+    void Schedule(const FSoftObjectPath& Path, float DelaySeconds);
+    bool Cancel(const FSoftObjectPath& Path);
+    bool IsScheduled(const FSoftObjectPath& Path) const { return NodeLookup.Contains(Path); }
+    int32 Num() const { return NodeLookup.Num(); }
+    SIZE_T GetAllocatedSize() const { return Nodes.GetAllocatedSize() + FreeNodes.GetAllocatedSize() + NodeLookup.GetAllocatedSize(); }
+
+    /** Advances the wheel by DeltaTime and appends the paths whose timer expired */
+    void Advance(float DeltaTime, TArray<FSoftObjectPath>& OutExpired);
+    void Empty();
+
+private:
+    static constexpr int32 LevelCount = 3;
+    static constexpr int32 SlotBits = 6;
+    static constexpr int32 SlotCount = 1 << SlotBits;
+    static constexpr uint64 SlotMask = SlotCount - 1;
+    static constexpr uint64 MaxDelayTicks = (1ull << (SlotBits * LevelCount)) - 1;
+
+    struct FTimerNode
+    {
+        FSoftObjectPath Path;
+        uint64 ExpireTick = 0;
+        int32 Prev = INDEX_NONE;
+        int32 Next = INDEX_NONE;
+        int32 Slot = INDEX_NONE;
+    };
+
+    void Link(const int32 NodeIndex);
+    void Unlink(const int32 NodeIndex);
+    void FreeNode(const int32 NodeIndex);
+    void Cascade(const int32 Level);
+    void Step(TArray<FSoftObjectPath>& OutExpired);
+
+    TArray<FTimerNode> Nodes;
+    TArray<int32> FreeNodes;
+    TMap<FSoftObjectPath, int32> NodeLookup;
+    int32 SlotHeads[LevelCount * SlotCount];
+
+    uint64 CurrentTick = 0;
+    float TickSeconds;
+    float AccumulatedSeconds = 0.f;
+};
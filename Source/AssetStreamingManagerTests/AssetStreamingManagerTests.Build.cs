@@ -0,0 +1,23 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// Automation tests and benchmarks of AssetStreamingManager, editor only so none of it ships
+public class AssetStreamingManagerTests : ModuleRules
+{
+	public AssetStreamingManagerTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"Json",
+				"AssetStreamingManager",
+			}
+		);
+	}
+}
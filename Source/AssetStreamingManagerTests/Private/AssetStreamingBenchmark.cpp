@@ -0,0 +1,141 @@
+#include "AssetStreamingTest.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+/**
+ * Scalability benchmark for the request queues, run with "Automation RunTests AssetStreaming.Benchmark".
+ * Uses UAssetStreamingBenchmarkSubsystem so only the queueing code is measured, every load completes one frame after it is issued.
+ * Results are added as automation telemetry and written to Saved/Automation/AssetStreamingBenchmark/Pending<N>.json.
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FAssetStreamingBenchmark, "AssetStreaming.Benchmark.Queue", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter);
+
+void FAssetStreamingBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    for (const int32 RequestCount : { 1000, 10000, 100000 })
+    {
+        OutBeautifiedNames.Add(FString::Printf(TEXT("Pending%d"), RequestCount));
+        OutTestCommands.Add(FString::FromInt(RequestCount));
+    }
+}
+
+bool FAssetStreamingBenchmark::RunTest(const FString& Parameters)
+{
+    const int32 RequestCount = FCString::Atoi(*Parameters);
+    if (!TestTrue(TEXT("Request count"), RequestCount > 0))
+    {
+        return false;
+    }
+
+    // Fixed seed so runs are comparable
+    FRandomStream Random(0x5EED);
+    TArray<FSoftObjectPath> AssetPaths;
+    AssetPaths.Reserve(RequestCount);
+    for (int32 Index = 0; Index < RequestCount; ++Index)
+    {
+        AssetPaths.Emplace(FString::Printf(TEXT("/Game/Benchmark/Asset_%d.Asset_%d"), Index, Index));
+    }
+
+    UAssetStreamingBenchmarkSubsystem* Subsystem = NewObject<UAssetStreamingBenchmarkSubsystem>(GetTransientPackage());
+    Subsystem->AddToRoot();
+    const SIZE_T BaseAllocatedSize = Subsystem->GetAllocatedSize();
+
+    // Enqueue, 1% of the requests go through the bounded priority queues and may be dropped
+    TArray<FAssetRequestHandle> Handles;
+    Handles.Reserve(RequestCount);
+    int32 DroppedCount = 0;
+    double StartTime = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < RequestCount; ++Index)
+    {
+        const int32 Priority = Random.FRand() < 0.01f ? Random.RandRange(1, 109) : 0;
+        FAssetRequestHandle Handle;
+        if (Subsystem->RequestAssetStreaming(AssetPaths[Index], Handle, Priority))
+        {
+            Handles.Add(Handle);
+        }
+        else
+        {
+            ++DroppedCount;
+        }
+    }
+    const double EnqueueSeconds = FPlatformTime::Seconds() - StartTime;
+    const int32 PendingCount = Subsystem->GetPendingRequestCount();
+    const double BytesPerRequest = static_cast<double>(Subsystem->GetAllocatedSize() - BaseAllocatedSize) / FMath::Max(PendingCount, 1);
+
+    // Cancel 10% of the pending requests, leaves stale heap entries behind for the drain to skip
+    const int32 CancelAttempts = Handles.Num() / 10;
+    int32 CancelCount = 0;
+    StartTime = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < CancelAttempts; ++Index)
+    {
+        // Requests evicted from a full priority queue have a stale handle and fail here
+        CancelCount += Subsystem->CancelRequest(Handles[Index * 10]) ? 1 : 0;
+    }
+    const double CancelSeconds = FPlatformTime::Seconds() - StartTime;
+
+    // Drain, every issued load completes on the next frame
+    int32 FrameCount = 0;
+    int32 LoadedCount = 0;
+    double TickSeconds = 0.0;
+    double MaxTickSeconds = 0.0;
+    const int32 MaxFrames = RequestCount * 2 + 1000;
+    while ((Subsystem->GetPendingRequestCount() > 0 || Subsystem->NumPendingLoads() > 0) && FrameCount < MaxFrames)
+    {
+        LoadedCount += Subsystem->CompletePendingLoads();
+
+        StartTime = FPlatformTime::Seconds();
+        Subsystem->Tick(1.f / 60.f);
+        const double FrameTickSeconds = FPlatformTime::Seconds() - StartTime;
+
+        TickSeconds += FrameTickSeconds;
+        MaxTickSeconds = FMath::Max(MaxTickSeconds, FrameTickSeconds);
+        ++FrameCount;
+    }
+    TestTrue(TEXT("Queues drained"), FrameCount < MaxFrames);
+    TestEqual(TEXT("Every pending request was issued"), LoadedCount, PendingCount - CancelCount);
+
+    // Release
+    StartTime = FPlatformTime::Seconds();
+    Subsystem->ReleaseAssets(Handles);
+    const double ReleaseSeconds = FPlatformTime::Seconds() - StartTime;
+
+    const FAssetStreamingLatencyHistogram& Latency = Subsystem->GetTelemetry().GetTotalLatency();
+    TMap<FString, double> Results;
+    Results.Add(TEXT("PendingRequests"), PendingCount);
+    Results.Add(TEXT("DroppedRequests"), DroppedCount);
+    Results.Add(TEXT("EnqueueNsPerRequest"), EnqueueSeconds * 1e9 / RequestCount);
+    Results.Add(TEXT("CancelNsPerRequest"), CancelSeconds * 1e9 / FMath::Max(CancelAttempts, 1));
+    Results.Add(TEXT("ReleaseNsPerRequest"), ReleaseSeconds * 1e9 / FMath::Max(Handles.Num(), 1));
+    Results.Add(TEXT("BytesPerPendingRequest"), BytesPerRequest);
+    Results.Add(TEXT("Frames"), FrameCount);
+    Results.Add(TEXT("TickAverageUs"), TickSeconds * 1e6 / FMath::Max(FrameCount, 1));
+    Results.Add(TEXT("TickMaxUs"), MaxTickSeconds * 1e6);
+    Results.Add(TEXT("DequeueNsPerRequest"), TickSeconds * 1e9 / FMath::Max(LoadedCount, 1));
+    Results.Add(TEXT("LatencyP50Ms"), Latency.GetPercentile(0.50) * 1000.0);
+    Results.Add(TEXT("LatencyP95Ms"), Latency.GetPercentile(0.95) * 1000.0);
+    Results.Add(TEXT("LatencyP99Ms"), Latency.GetPercentile(0.99) * 1000.0);
+
+    FString Json;
+    TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("Benchmark"), TEXT("AssetStreaming.Benchmark.Queue"));
+    Writer->WriteValue(TEXT("RequestCount"), RequestCount);
+    Writer->WriteValue(TEXT("MaxAssetsToLoadPerTick"), IConsoleManager::Get().FindConsoleVariable(TEXT("StreamingManager.MaxAssetsToLoadPerTick"))->GetInt());
+    for (const TPair<FString, double>& Result : Results)
+    {
+        Writer->WriteValue(Result.Key, Result.Value);
+        AddTelemetryData(Result.Key, Result.Value, Parameters);
+    }
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    const FString OutputPath = FPaths::Combine(FPaths::AutomationDir(), TEXT("AssetStreamingBenchmark"), FString::Printf(TEXT("Pending%d.json"), RequestCount));
+    TestTrue(TEXT("Write benchmark results"), FFileHelper::SaveStringToFile(Json, *OutputPath));
+    AddInfo(FString::Printf(TEXT("Benchmark results written to %s"), *OutputPath));
+
+    Subsystem->RemoveFromRoot();
+    Subsystem->MarkAsGarbage();
+    return true;
+}
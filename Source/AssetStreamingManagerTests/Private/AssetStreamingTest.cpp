@@ -0,0 +1,312 @@
+#include "AssetStreamingTest.h"
+#include "Misc/AutomationTest.h"
+#include "Engine/Engine.h"
+
+static const FSoftObjectPath TestAssetPath(TEXT("/Game/TestContents/Textures/T_UEFN_Mannequin_D.T_UEFN_Mannequin_D"));
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingSubsystem_BasicTest, "AssetStreaming.Basic.RequestAndRelease", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+
+bool FAssetStreamingSubsystem_BasicTest::RunTest(const FString& Parameters)
+{
+    UAssetStreamingSubsystem* Subsystem = GEngine->GetEngineSubsystem<UAssetStreamingSubsystem>();
+    TestNotNull(TEXT("Subsystem should not be null"), Subsystem);
+
+    // 1. ⺻ û (Default Queue)
+    FAssetRequestHandle RequestId;
+    bool bRequested = Subsystem->RequestAssetStreaming(TestAssetPath, RequestId, 0);
+    TestTrue(TEXT("RequestAssetStreaming(Default) returns true"), bRequested);
+    TestTrue(TEXT("RequestId is valid"), RequestId.IsValid());
+
+    // 2. 켱 û (Priority Queue)
+    FAssetRequestHandle PriorityRequestId;
+    int32 Priority = 10;
+    bool bPriorityRequested = Subsystem->RequestAssetStreaming(TestAssetPath, PriorityRequestId, Priority);
+    TestTrue(TEXT("RequestAssetStreaming(Priority) returns true"), bPriorityRequested);
+    TestTrue(TEXT("PriorityRequestId is valid"), PriorityRequestId.IsValid());
+
+    // 3. ϰ û
+    TArray<FSoftObjectPath> AssetPaths = { TestAssetPath, TestAssetPath };
+    TArray<FAssetRequestHandle> BatchRequestIds;
+    bool bBatchRequested = Subsystem->RequestAssetsStreaming(AssetPaths, BatchRequestIds, 0);
+    TestTrue(TEXT("RequestAssetsStreaming returns true"), bBatchRequested);
+    TestEqual(TEXT("BatchRequestIds count"), BatchRequestIds.Num(), 2);
+
+    // 4. Ʈ ε  ȣ ׽Ʈ
+    UAssetStreamingTestHelper* Helper = NewObject<UAssetStreamingTestHelper>();
+    Helper->AddToRoot();
+    Subsystem->OnAssetLoaded.AddDynamic(Helper, &UAssetStreamingTestHelper::OnAssetLoaded);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        Subsystem->Tick(0.01f); //   ȣ
+        if (Helper->bDelegateCalled)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Delegate triggered at tick %d"), i);
+            break;
+        }
+    }
+    TestTrue(TEXT("OnAssetLoaded delegate should be called"), Helper->bDelegateCalled);
+
+    Subsystem->OnAssetLoaded.RemoveDynamic(Helper, &UAssetStreamingTestHelper::OnAssetLoaded);
+    
+    // 5.  ε ׽Ʈ
+    UObject* Asset = Subsystem->LoadAssetSync(TestAssetPath);
+	bool bSyncLoaded = (Asset != nullptr);
+    TestTrue(TEXT("Sync Loading returns object"), bSyncLoaded);
+
+    // 6.  ׽Ʈ
+    bool bReleased = Subsystem->ReleaseAsset(RequestId);
+    TestTrue(TEXT("ReleaseAsset returns true"), bReleased);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingSubsystem_ReprioritizeTest, "AssetStreaming.Basic.ReprioritizeAndCancel", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FAssetStreamingSubsystem_ReprioritizeTest::RunTest(const FString& Parameters)
+{
+    UAssetStreamingSubsystem* Subsystem = GEngine->GetEngineSubsystem<UAssetStreamingSubsystem>();
+    if (!TestNotNull(TEXT("Subsystem should not be null"), Subsystem))
+    {
+        return false;
+    }
+
+    FAssetRequestHandle RequestId;
+    Subsystem->RequestAssetStreaming(TestAssetPath, RequestId, 0);
+    TestTrue(TEXT("Request is pending before tick"), Subsystem->IsRequestPending(RequestId));
+
+    TestTrue(TEXT("Pending request can be promoted"), Subsystem->UpdateRequestPriority(RequestId, 100));
+    TestTrue(TEXT("Promoted request is still pending"), Subsystem->IsRequestPending(RequestId));
+    TestTrue(TEXT("Pending request can be demoted"), Subsystem->UpdateRequestPriority(RequestId, 0));
+
+    const FAssetRequestHandle CancelledHandleCopy = RequestId;
+    FAssetRequestHandle CancelledId = RequestId;
+    TestTrue(TEXT("Pending request can be cancelled"), Subsystem->CancelRequest(CancelledId));
+    TestFalse(TEXT("CancelRequest invalidates the id"), CancelledId.IsValid());
+    TestFalse(TEXT("Cancelled request is no longer pending"), Subsystem->IsRequestPending(RequestId));
+    TestFalse(TEXT("Cancelled request cannot be reprioritized"), Subsystem->UpdateRequestPriority(RequestId, 50));
+    TestFalse(TEXT("Cancelled request cannot be released"), Subsystem->ReleaseAsset(RequestId));
+
+    // The freed slot is reused by the next request, the stale handle must not resolve to it
+    const FAssetRequestHandle StaleHandle = CancelledHandleCopy;
+    FAssetRequestHandle ReusedHandle;
+    Subsystem->RequestAssetStreaming(TestAssetPath, ReusedHandle, 0);
+    TestEqual(TEXT("Freed slot is reused"), ReusedHandle.Index, StaleHandle.Index);
+    TestFalse(TEXT("Stale handle is rejected"), Subsystem->IsRequestValid(StaleHandle));
+    TestTrue(TEXT("Reused handle is valid"), Subsystem->IsRequestValid(ReusedHandle));
+    Subsystem->CancelRequest(ReusedHandle);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingSubsystem_FullGroupTest, "AssetStreaming.Basic.FullPriorityGroup", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FAssetStreamingSubsystem_FullGroupTest::RunTest(const FString& Parameters)
+{
+    UAssetStreamingBenchmarkSubsystem* Subsystem = NewObject<UAssetStreamingBenchmarkSubsystem>(GetTransientPackage());
+    Subsystem->AddToRoot();
+
+    // Fill the 50-59 group until it drops a request of the same priority
+    TArray<FAssetRequestHandle> GroupHandles;
+    FAssetRequestHandle Handle;
+    while (GroupHandles.Num() < 64 && Subsystem->RequestAssetStreaming(TestAssetPath, Handle, 50))
+    {
+        GroupHandles.Add(Handle);
+    }
+    TestFalse(TEXT("Dropped request has an invalid handle"), Handle.IsValid());
+
+    FAssetRequestHandle DefaultHandle;
+    Subsystem->RequestAssetStreaming(TestAssetPath, DefaultHandle, 0);
+    TestFalse(TEXT("Move into a full group is rejected"), Subsystem->UpdateRequestPriority(DefaultHandle, 55));
+    TestTrue(TEXT("Rejected request is still pending"), Subsystem->IsRequestPending(DefaultHandle));
+    bool bAllGroupPending = true;
+    for (const FAssetRequestHandle& GroupHandle : GroupHandles)
+    {
+        bAllGroupPending &= Subsystem->IsRequestPending(GroupHandle);
+    }
+    TestTrue(TEXT("Nobody was evicted by the rejected move"), bAllGroupPending);
+
+    TArray<FSoftObjectPath> AssetPaths = { TestAssetPath };
+    TArray<FAssetRequestHandle> BatchHandles;
+    TestFalse(TEXT("Batch with a dropped request returns false"), Subsystem->RequestAssetsStreaming(AssetPaths, BatchHandles, 50));
+    TestTrue(TEXT("Dropped batch handle is kept in place"), BatchHandles.Num() == 1 && !BatchHandles[0].IsValid());
+
+    Subsystem->RemoveFromRoot();
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingUnloadTimerWheelTest, "AssetStreaming.Basic.UnloadTimerWheel", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FAssetStreamingUnloadTimerWheelTest::RunTest(const FString& Parameters)
+{
+    FAssetUnloadTimerWheel Wheel(0.1f);
+    const FSoftObjectPath ShortPath(TEXT("/Game/Test/Short.Short"));
+    const FSoftObjectPath LongPath(TEXT("/Game/Test/Long.Long"));
+    const FSoftObjectPath CancelledPath(TEXT("/Game/Test/Cancelled.Cancelled"));
+
+    Wheel.Schedule(ShortPath, 1.f);
+    Wheel.Schedule(LongPath, 600.f); // Lands on the top level and has to cascade down
+    Wheel.Schedule(CancelledPath, 1.f);
+    TestTrue(TEXT("Cancel scheduled timer"), Wheel.Cancel(CancelledPath));
+
+    TArray<FSoftObjectPath> Expired;
+    Wheel.Advance(0.5f, Expired);
+    TestEqual(TEXT("Nothing expired early"), Expired.Num(), 0);
+
+    Wheel.Schedule(ShortPath, 1.f); // Reschedule restarts the delay
+    Wheel.Advance(0.75f, Expired);
+    TestEqual(TEXT("Rescheduled timer not yet expired"), Expired.Num(), 0);
+    Wheel.Advance(0.5f, Expired);
+    TestTrue(TEXT("Short timer expired"), Expired.Num() == 1 && Expired[0] == ShortPath);
+
+    Expired.Reset();
+    for (int32 Frame = 0; Frame < 600 * 60 && Expired.Num() == 0; ++Frame)
+    {
+        Wheel.Advance(1.f / 60.f, Expired);
+    }
+    TestTrue(TEXT("Long timer expired after cascading"), Expired.Num() == 1 && Expired[0] == LongPath);
+    TestEqual(TEXT("Wheel is empty"), Wheel.Num(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingLatencyHistogramTest, "AssetStreaming.Basic.LatencyHistogram", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FAssetStreamingLatencyHistogramTest::RunTest(const FString& Parameters)
+{
+    FAssetStreamingLatencyHistogram Histogram;
+    TestEqual(TEXT("Empty histogram reports 0"), Histogram.GetPercentile(0.5), 0.0);
+
+    for (int32 Milliseconds = 1; Milliseconds <= 100; ++Milliseconds)
+    {
+        Histogram.Add(Milliseconds / 1000.0);
+    }
+    TestEqual(TEXT("Sample count"), Histogram.Num(), static_cast<int64>(100));
+
+    // Quarter octave buckets, a percentile is at most 2^(1/4) above the exact sample
+    const double P50 = Histogram.GetPercentile(0.5);
+    TestTrue(TEXT("P50 within one bucket of 50ms"), P50 >= 0.050 && P50 <= 0.050 * 1.19);
+    const double P99 = Histogram.GetPercentile(0.99);
+    TestTrue(TEXT("P99 clamped to the slowest sample"), P99 >= 0.099 && P99 <= 0.100);
+
+    Histogram.Reset();
+    TestEqual(TEXT("Reset clears samples"), Histogram.Num(), static_cast<int64>(0));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingDistancePriorityTest, "AssetStreaming.Basic.DistancePriority", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FAssetStreamingDistancePriorityTest::RunTest(const FString& Parameters)
+{
+    // Stand-in loader, nothing is issued to disk and requests stay in flight
+    UAssetStreamingBenchmarkSubsystem* Subsystem = NewObject<UAssetStreamingBenchmarkSubsystem>(GetTransientPackage());
+    Subsystem->AddToRoot();
+    Subsystem->SetStreamingSources({ FVector::ZeroVector });
+
+    const float Falloff = IConsoleManager::Get().FindConsoleVariable(TEXT("StreamingManager.DistancePriorityFalloff"))->GetFloat();
+    FAssetRequestHandle FarRequest;
+    TestTrue(TEXT("Request far away"), Subsystem->RequestAssetStreamingAtLocation(TestAssetPath, FarRequest, FVector(Falloff * 2.f, 0.f, 0.f), 100));
+    TestEqual(TEXT("Beyond falloff goes to the default queue"), Subsystem->GetRequestPriority(FarRequest), 0);
+
+    FAssetRequestHandle CellRequest;
+    TestTrue(TEXT("Request at cell"), Subsystem->RequestAssetStreamingAtCell(TestAssetPath, CellRequest, FInt64Vector(0, 0, 0), 100, 100));
+    TestTrue(TEXT("Nearby cell keeps almost full priority"), Subsystem->GetRequestPriority(CellRequest) >= 99);
+
+    // Moving the source next to the far request raises it on the next pass
+    Subsystem->SetStreamingSources({ FVector(Falloff * 2.f, 0.f, 0.f) });
+    Subsystem->Tick(0.f);
+    TestTrue(TEXT("Far request re-prioritized"), Subsystem->GetRequestPriority(FarRequest) >= 99);
+
+    Subsystem->ReleaseAsset(FarRequest);
+    Subsystem->ReleaseAsset(CellRequest);
+    Subsystem->RemoveFromRoot();
+    Subsystem->MarkAsGarbage();
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingUrgentLoadTest, "AssetStreaming.Basic.UrgentLoad", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FAssetStreamingUrgentLoadTest::RunTest(const FString& Parameters)
+{
+    UAssetStreamingBenchmarkSubsystem* Subsystem = NewObject<UAssetStreamingBenchmarkSubsystem>(GetTransientPackage());
+    Subsystem->AddToRoot();
+
+    FAssetRequestHandle QueuedRequest;
+    Subsystem->RequestAssetStreaming(TestAssetPath, QueuedRequest, 0);
+
+    // The stand-in loader never completes on its own, so the future is only set once the load completes
+    FAssetRequestHandle UrgentRequest;
+    TFuture<UObject*> Future = Subsystem->LoadAssetUrgent(TestAssetPath, UrgentRequest);
+    TestTrue(TEXT("Urgent request is valid"), UrgentRequest.IsValid());
+    TestFalse(TEXT("Urgent request is issued, not queued"), Subsystem->IsRequestPending(UrgentRequest));
+    TestTrue(TEXT("Queued request for the same asset is promoted"), Subsystem->GetRequestPriority(QueuedRequest) > 100);
+    TestFalse(TEXT("Future not ready before the load completes"), Future.IsReady());
+
+    Subsystem->CompletePendingLoads();
+    TestTrue(TEXT("Future ready once loaded"), Future.IsReady());
+
+    // Releasing before completion still sets the future
+    FAssetRequestHandle ReleasedRequest;
+    TFuture<UObject*> ReleasedFuture = Subsystem->LoadAssetUrgent(TestAssetPath, ReleasedRequest);
+    Subsystem->ReleaseAsset(ReleasedRequest);
+    TestTrue(TEXT("Future set with nullptr on release"), ReleasedFuture.IsReady() && ReleasedFuture.Get() == nullptr);
+
+    Subsystem->ReleaseAsset(QueuedRequest);
+    Subsystem->ReleaseAsset(UrgentRequest);
+    Subsystem->RemoveFromRoot();
+    Subsystem->MarkAsGarbage();
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingResidencyTest, "AssetStreaming.Basic.CategoryBudgets", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FAssetStreamingResidencyTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 Mesh = 0;
+    constexpr int32 Audio = 1;
+    FAssetStreamingResidency Residency(2);
+    Residency.SetBudget(Mesh, 300);
+    Residency.SetBudget(Audio, 200);
+
+    const FSoftObjectPath MeshA(TEXT("/Game/Test/MeshA.MeshA"));
+    const FSoftObjectPath MeshB(TEXT("/Game/Test/MeshB.MeshB"));
+    Residency.Add(MeshA, Mesh, 100);
+    Residency.Add(MeshB, Mesh, 100);
+    Residency.MarkReleased(MeshA);
+
+    // Audio burst, all released right away
+    TArray<FSoftObjectPath> AudioBanks;
+    for (int32 Index = 0; Index < 5; ++Index)
+    {
+        AudioBanks.Emplace(FString::Printf(TEXT("/Game/Test/Bank%d.Bank%d"), Index, Index));
+        Residency.Add(AudioBanks.Last(), Audio, 100);
+        Residency.MarkReleased(AudioBanks.Last());
+    }
+    Residency.MarkRequested(AudioBanks[0]);
+    TestEqual(TEXT("Peak audio bytes"), Residency.GetPeakResidentBytes(Audio), static_cast<int64>(500));
+
+    TArray<FSoftObjectPath> Evicted;
+    Residency.GatherEvictions(Evicted);
+    TestTrue(TEXT("Oldest released audio evicted first, requested bank kept"), Evicted.Num() == 3 && Evicted[0] == AudioBanks[1] && Evicted[2] == AudioBanks[3]);
+    TestFalse(TEXT("Meshes under budget are not evicted"), Evicted.Contains(MeshA));
+
+    for (const FSoftObjectPath& Path : Evicted)
+    {
+        Residency.RecordEvicted(Path);
+        Residency.Remove(Path);
+    }
+    TestEqual(TEXT("Audio back under budget"), Residency.GetResidentBytes(Audio), static_cast<int64>(200));
+    TestEqual(TEXT("Mesh bytes untouched"), Residency.GetResidentBytes(Mesh), static_cast<int64>(200));
+    TestEqual(TEXT("Audio evictions"), Residency.GetEvictionCount(Audio), static_cast<int64>(3));
+
+    // The disk size estimate is replaced by the measured memory size
+    TestFalse(TEXT("Added assets are estimates"), Residency.IsMeasured(MeshB));
+    TestTrue(TEXT("Tracked asset can be measured"), Residency.SetMeasuredBytes(MeshB, 250));
+    TestTrue(TEXT("Measured asset is flagged"), Residency.IsMeasured(MeshB));
+    TestEqual(TEXT("Mesh bytes use the measured size"), Residency.GetResidentBytes(Mesh), static_cast<int64>(350));
+    TestEqual(TEXT("Peak follows the measured size"), Residency.GetPeakResidentBytes(Mesh), static_cast<int64>(350));
+
+    return true;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "AssetStreamingSubsystem.h"
+#include "AssetStreamingTest.generated.h"
+
+UCLASS()
+class UAssetStreamingTestHelper : public UObject
+{
+    GENERATED_BODY()
+public:
+    bool bDelegateCalled = false;
+
+    UFUNCTION()
+    void OnAssetLoaded(UObject* LoadedAsset, bool bAlreadyLoaded)
+    {
+        bDelegateCalled = true;
+    }
+};
+
+/** Stand-in loader for the benchmark suite, requests never touch disk and complete when CompletePendingLoads is called */
+UCLASS(Transient)
+class UAssetStreamingBenchmarkSubsystem : public UAssetStreamingSubsystem
+{
+    GENERATED_BODY()
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override { return false; }
+    // Ticked manually by the benchmark only
+    virtual bool IsTickable() const override { return false; }
+
+    int32 CompletePendingLoads()
+    {
+        TArray<FStreamableDelegate> Completed = MoveTemp(PendingLoads);
+        PendingLoads.Reset();
+        for (FStreamableDelegate& OnLoaded : Completed)
+        {
+            OnLoaded.ExecuteIfBound();
+        }
+        return Completed.Num();
+    }
+    int32 NumPendingLoads() const { return PendingLoads.Num(); }
+
+protected:
+    virtual bool IsAssetLoadComplete(const FSoftObjectPath& AssetPath) const override { return false; }
+    virtual TSharedPtr<FStreamableHandle> RequestAsyncLoad(const FSoftObjectPath& AssetPath, FStreamableDelegate OnLoaded, const TAsyncLoadPriority AsyncLoadPriority) override
+    {
+        PendingLoads.Add(MoveTemp(OnLoaded));
+        return nullptr;
+    }
+
+private:
+    TArray<FStreamableDelegate> PendingLoads;
+};
@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldGridStreamCollisionStreaming.h"
+#include "GameFramework/Actor.h"
+#include "Components/PrimitiveComponent.h"
+
+#include "WorldGridStreamPrivate.h"
+
+BEGIN_FUNCTION_BUILD_OPTIMIZATION
+
+void FWorldGridStreamCollisionStreaming::DisableActor(const FInt64Vector& InGridIndex, AActor* InActor)
+{
+	if (false == ::IsValid(InActor) || false == InActor->GetActorEnableCollision())
+	{
+		return;
+	}
+
+	InActor->SetActorEnableCollision(false);
+	InActor->ForEachComponent<UPrimitiveComponent>(false, [](UPrimitiveComponent* Component)
+	{
+		if (true == Component->IsPhysicsStateCreated())
+		{
+			Component->DestroyPhysicsState();
+		}
+	});
+	DisabledCells.FindOrAdd(InGridIndex).Add(InActor);
+}
+
+void FWorldGridStreamCollisionStreaming::DisableCell(const FInt64Vector& InGridIndex, const TArray<AActor*>& InActors)
+{
+	DisabledCells.FindOrAdd(InGridIndex);
+
+	for (AActor* Actor : InActors)
+	{
+		// Templates loaded with the cell package are not in a world and have no physics state
+		if (true == ::IsValid(Actor) && nullptr != Actor->GetWorld())
+		{
+			DisableActor(InGridIndex, Actor);
+		}
+	}
+}
+
+void FWorldGridStreamCollisionStreaming::EnableCell(const FInt64Vector& InGridIndex)
+{
+	TArray<TWeakObjectPtr<AActor>> Actors;
+	if (false == DisabledCells.RemoveAndCopyValue(InGridIndex, Actors))
+	{
+		return;
+	}
+
+	for (const TWeakObjectPtr<AActor>& WeakActor : Actors)
+	{
+		AActor* Actor = WeakActor.Get();
+		if (nullptr == Actor)
+		{
+			continue;
+		}
+
+		Actor->SetActorEnableCollision(true);
+		Actor->ForEachComponent<UPrimitiveComponent>(false, [](UPrimitiveComponent* Component)
+		{
+			// Only creates a body when the component has collision
+			if (true == Component->IsRegistered() && false == Component->IsPhysicsStateCreated())
+			{
+				Component->RecreatePhysicsState();
+			}
+		});
+	}
+}
+
+END_FUNCTION_BUILD_OPTIMIZATION
@@ -0,0 +1,286 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldGridStreamContext.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/ARFilter.h"
+#include "Misc/Parse.h"
+
+#include "WorldGridStreamPrivate.h"
+#include "WorldGridStreamInstances.h"
+#include "WorldGridStreamInstancesActor.h"
+
+BEGIN_FUNCTION_BUILD_OPTIMIZATION
+
+const TCHAR* LexToString(EWorldGridStreamCellState InState)
+{
+	switch (InState)
+	{
+	case EWorldGridStreamCellState::Unloaded:		return TEXT("Unloaded");
+	case EWorldGridStreamCellState::Requested:		return TEXT("Requested");
+	case EWorldGridStreamCellState::Loading:		return TEXT("Loading");
+	case EWorldGridStreamCellState::Loaded:			return TEXT("Loaded");
+	case EWorldGridStreamCellState::Activating:		return TEXT("Activating");
+	case EWorldGridStreamCellState::Active:			return TEXT("Active");
+	case EWorldGridStreamCellState::Dormant:		return TEXT("Dormant");
+	case EWorldGridStreamCellState::Deactivating:	return TEXT("Deactivating");
+	default:										return TEXT("Invalid");
+	}
+}
+
+void FWorldGridStreamContext::Initialize(UWorld* InWorld)
+{
+	Reset();
+	World = InWorld;
+	MapName = nullptr != InWorld ? UWorld::RemovePIEPrefix(InWorld->GetMapName()) : FString();
+}
+
+void FWorldGridStreamContext::Reset()
+{
+	World.Reset();
+	InstancesActor.Reset();
+	Cells.Empty();
+	MapName.Reset();
+	CellPackages.Empty();
+	MinCellZ = 0;
+	MaxCellZ = -1;
+	for (int32 StateIndex = 0; StateIndex < static_cast<int32>(EWorldGridStreamCellState::Num); ++StateIndex)
+	{
+		StateCounts[StateIndex] = 0;
+		StateTimings[StateIndex] = FWorldGridStreamCellStateTiming();
+	}
+}
+
+AWorldGridStreamInstancesActor* FWorldGridStreamContext::GetInstancesActor()
+{
+	if (false == InstancesActor.IsValid() && true == World.IsValid())
+	{
+		InstancesActor = AWorldGridStreamInstancesActor::GetWorldGridStreamInstancesActor(World.Get());
+	}
+	return InstancesActor.Get();
+}
+
+void FWorldGridStreamContext::GatherCellPackages()
+{
+	CellPackages.Reset();
+	MinCellZ = 0;
+	MaxCellZ = -1;
+	IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+	if (nullptr == AssetRegistry || true == MapName.IsEmpty())
+	{
+		return;
+	}
+
+	FARFilter Filter;
+	Filter.PackagePaths.Add(TEXT("/Game/WorldGridStream"));
+	Filter.ClassPaths.Add(UWorldGridStreamInstances::StaticClass()->GetClassPathName());
+	TArray<FAssetData> Assets;
+	AssetRegistry->GetAssets(Filter, Assets);
+
+	const FString Prefix = MapName + TEXT("_");
+	for (const FAssetData& Asset : Assets)
+	{
+		const FString AssetName = Asset.AssetName.ToString();
+		if (false == AssetName.StartsWith(Prefix))
+		{
+			continue;
+		}
+
+		// FInt64Vector::ToString, X=0 Y=0 Z=0
+		const TCHAR* GridIndexString = *AssetName + Prefix.Len();
+		FInt64Vector GridIndex;
+		if (false == FParse::Value(GridIndexString, TEXT("X="), GridIndex.X) || false == FParse::Value(GridIndexString, TEXT("Y="), GridIndex.Y) || false == FParse::Value(GridIndexString, TEXT("Z="), GridIndex.Z))
+		{
+			continue;
+		}
+
+		MinCellZ = CellPackages.Num() > 0 ? FMath::Min(MinCellZ, GridIndex.Z) : GridIndex.Z;
+		MaxCellZ = CellPackages.Num() > 0 ? FMath::Max(MaxCellZ, GridIndex.Z) : GridIndex.Z;
+		CellPackages.Add(GridIndex, Asset.PackageName);
+	}
+	UE_LOG(LogWGS, Log, TEXT("%s: %d cell packages"), *MapName, CellPackages.Num());
+}
+
+UWorldGridStreamInstances* FWorldGridStreamContext::FindInstances(const FInt64Vector& InGridIndex)
+{
+	if (const FWorldGridStreamCell* Cell = Cells.Find(InGridIndex))
+	{
+		if (UWorldGridStreamInstances* Instances = Cell->Instances.Get())
+		{
+			return Instances;
+		}
+	}
+
+	AWorldGridStreamInstancesActor* WorldGridStreamInstancesActor = GetInstancesActor();
+	return nullptr != WorldGridStreamInstancesActor ? WorldGridStreamInstancesActor->WorldGridStreamInstancesMap.FindRef(InGridIndex).Get() : nullptr;
+}
+
+EWorldGridStreamCellState FWorldGridStreamContext::GetCellState(const FInt64Vector& InGridIndex) const
+{
+	const FWorldGridStreamCell* Cell = Cells.Find(InGridIndex);
+	return nullptr != Cell ? Cell->State : EWorldGridStreamCellState::Unloaded;
+}
+
+bool FWorldGridStreamContext::IsValidTransition(EWorldGridStreamCellState From, EWorldGridStreamCellState To)
+{
+	switch (From)
+	{
+	case EWorldGridStreamCellState::Unloaded:		return To == EWorldGridStreamCellState::Requested;
+	case EWorldGridStreamCellState::Requested:		return To == EWorldGridStreamCellState::Loading || To == EWorldGridStreamCellState::Unloaded;
+	case EWorldGridStreamCellState::Loading:		return To == EWorldGridStreamCellState::Loaded || To == EWorldGridStreamCellState::Unloaded;
+	case EWorldGridStreamCellState::Loaded:			return To == EWorldGridStreamCellState::Activating || To == EWorldGridStreamCellState::Unloaded;
+	case EWorldGridStreamCellState::Activating:		return To == EWorldGridStreamCellState::Active || To == EWorldGridStreamCellState::Deactivating;
+	case EWorldGridStreamCellState::Active:			return To == EWorldGridStreamCellState::Dormant || To == EWorldGridStreamCellState::Deactivating;
+	case EWorldGridStreamCellState::Dormant:		return To == EWorldGridStreamCellState::Active || To == EWorldGridStreamCellState::Deactivating;
+	case EWorldGridStreamCellState::Deactivating:	return To == EWorldGridStreamCellState::Unloaded;
+	default:										return false;
+	}
+}
+
+bool FWorldGridStreamContext::SetCellState(const FInt64Vector& InGridIndex, EWorldGridStreamCellState InState)
+{
+	FWorldGridStreamCell* Cell = Cells.Find(InGridIndex);
+	const EWorldGridStreamCellState CurrentState = nullptr != Cell ? Cell->State : EWorldGridStreamCellState::Unloaded;
+	if (false == IsValidTransition(CurrentState, InState))
+	{
+		UE_LOG(LogWGS, Warning, TEXT("Cell %s: Invalid state transition %s -> %s"), *InGridIndex.ToString(), LexToString(CurrentState), LexToString(InState));
+		return false;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (nullptr == Cell)
+	{
+		Cell = &Cells.Add(InGridIndex);
+		Cell->GridIndex = InGridIndex;
+	}
+	else
+	{
+		LeaveState(*Cell, Now);
+	}
+
+	if (InState == EWorldGridStreamCellState::Unloaded)
+	{
+		Cells.Remove(InGridIndex);
+		return true;
+	}
+
+	Cell->State = InState;
+	Cell->StateStartTime = Now;
+	++StateCounts[static_cast<int32>(InState)];
+	return true;
+}
+
+void FWorldGridStreamContext::AddActiveCell(const FInt64Vector& InGridIndex, UWorldGridStreamInstances* InInstances)
+{
+	if (true == Cells.Contains(InGridIndex))
+	{
+		return;
+	}
+
+	FWorldGridStreamCell& Cell = Cells.Add(InGridIndex);
+	Cell.GridIndex = InGridIndex;
+	Cell.State = EWorldGridStreamCellState::Active;
+	Cell.StateStartTime = FPlatformTime::Seconds();
+	Cell.Instances = InInstances;
+	++StateCounts[static_cast<int32>(EWorldGridStreamCellState::Active)];
+}
+
+void FWorldGridStreamContext::SetCellInstances(const FInt64Vector& InGridIndex, UWorldGridStreamInstances* InInstances)
+{
+	if (FWorldGridStreamCell* Cell = Cells.Find(InGridIndex))
+	{
+		Cell->Instances = InInstances;
+	}
+}
+
+void FWorldGridStreamContext::SetCellLoadSerial(const FInt64Vector& InGridIndex, uint32 InLoadSerial)
+{
+	if (FWorldGridStreamCell* Cell = Cells.Find(InGridIndex))
+	{
+		Cell->LoadSerial = InLoadSerial;
+	}
+}
+
+void FWorldGridStreamContext::AddCellSpawnedActor(const FInt64Vector& InGridIndex, AActor* InActor)
+{
+	if (FWorldGridStreamCell* Cell = Cells.Find(InGridIndex))
+	{
+		Cell->SpawnedActors.Add(InActor);
+	}
+}
+
+void FWorldGridStreamContext::AddCellPlacedActor(const FInt64Vector& InGridIndex, AActor* InActor)
+{
+	AddActiveCell(InGridIndex, nullptr);
+	Cells.FindChecked(InGridIndex).PlacedActors.Add(InActor);
+}
+
+void FWorldGridStreamContext::GetCellSpawnedActors(const FInt64Vector& InGridIndex, TArray<AActor*>& OutActors) const
+{
+	const FWorldGridStreamCell* Cell = Cells.Find(InGridIndex);
+	if (nullptr == Cell)
+	{
+		return;
+	}
+
+	for (const TWeakObjectPtr<AActor>& WeakActor : Cell->SpawnedActors)
+	{
+		if (AActor* Actor = WeakActor.Get())
+		{
+			OutActors.Add(Actor);
+		}
+	}
+}
+
+void FWorldGridStreamContext::GetCellActors(const FInt64Vector& InGridIndex, TArray<AActor*>& OutActors) const
+{
+	GetCellSpawnedActors(InGridIndex, OutActors);
+	const FWorldGridStreamCell* Cell = Cells.Find(InGridIndex);
+	if (nullptr == Cell)
+	{
+		return;
+	}
+
+	for (const TWeakObjectPtr<AActor>& WeakActor : Cell->PlacedActors)
+	{
+		if (AActor* Actor = WeakActor.Get())
+		{
+			OutActors.Add(Actor);
+		}
+	}
+	if (const UWorldGridStreamInstances* WorldGridStreamInstances = Cell->Instances.Get())
+	{
+		OutActors.Append(WorldGridStreamInstances->WorldGridStreamActors);
+	}
+}
+
+double FWorldGridStreamContext::GetSecondsInState(const FInt64Vector& InGridIndex) const
+{
+	const FWorldGridStreamCell* Cell = Cells.Find(InGridIndex);
+	return nullptr != Cell ? FPlatformTime::Seconds() - Cell->StateStartTime : 0.0;
+}
+
+void FWorldGridStreamContext::DumpStates(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("WorldGridStream cells: %d tracked"), Cells.Num());
+	for (int32 StateIndex = 1; StateIndex < static_cast<int32>(EWorldGridStreamCellState::Num); ++StateIndex)
+	{
+		const FWorldGridStreamCellStateTiming& Timing = StateTimings[StateIndex];
+		Ar.Logf(TEXT("  %-12s Cells: %5d  Exits: %6d  Avg: %8.2fms  Max: %8.2fms"), LexToString(static_cast<EWorldGridStreamCellState>(StateIndex)),
+			StateCounts[StateIndex], Timing.ExitCount, Timing.GetAverageSeconds() * 1000.0, Timing.MaxSeconds * 1000.0);
+	}
+}
+
+void FWorldGridStreamContext::LeaveState(FWorldGridStreamCell& Cell, double Now)
+{
+	const int32 StateIndex = static_cast<int32>(Cell.State);
+	const double Seconds = Now - Cell.StateStartTime;
+	--StateCounts[StateIndex];
+	FWorldGridStreamCellStateTiming& Timing = StateTimings[StateIndex];
+	++Timing.ExitCount;
+	Timing.TotalSeconds += Seconds;
+	Timing.MaxSeconds = FMath::Max(Timing.MaxSeconds, Seconds);
+}
+
+END_FUNCTION_BUILD_OPTIMIZATION
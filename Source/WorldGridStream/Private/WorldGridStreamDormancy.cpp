@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldGridStreamDormancy.h"
+#include "GameFramework/Actor.h"
+#include "Components/PrimitiveComponent.h"
+
+#include "WorldGridStreamPrivate.h"
+
+BEGIN_FUNCTION_BUILD_OPTIMIZATION
+
+void FWorldGridStreamDormancy::MakeDormant(const FInt64Vector& InGridIndex, const TArray<AActor*>& InActors, bool bInUnregisterComponents)
+{
+	if (true == DormantCells.Contains(InGridIndex))
+	{
+		return;
+	}
+
+	FDormantCell& DormantCell = DormantCells.Add(InGridIndex);
+	for (AActor* Actor : InActors)
+	{
+		// Templates loaded with the cell package are not in a world, cells adopted from the map have their actors placed in it
+		if (false == ::IsValid(Actor) || nullptr == Actor->GetWorld())
+		{
+			continue;
+		}
+
+		FDormantActor& DormantActor = DormantCell.Actors.AddDefaulted_GetRef();
+		DormantActor.Actor = Actor;
+		DormantActor.bWasHidden = Actor->IsHidden();
+		DormantActor.bHadCollision = Actor->GetActorEnableCollision();
+		Actor->SetActorHiddenInGame(true);
+		Actor->SetActorEnableCollision(false);
+		if (true == Actor->IsActorTickEnabled())
+		{
+			Actor->SetActorTickEnabled(false);
+			DormantCell.TickDisabledObjects.Add(Actor);
+		}
+
+		Actor->ForEachComponent(false, [&DormantCell, bInUnregisterComponents](UActorComponent* Component)
+		{
+			if (true == Component->IsComponentTickEnabled())
+			{
+				Component->SetComponentTickEnabled(false);
+				DormantCell.TickDisabledObjects.Add(Component);
+			}
+			if (true == bInUnregisterComponents && true == Component->IsRegistered() && nullptr != Cast<UPrimitiveComponent>(Component))
+			{
+				Component->UnregisterComponent();
+				DormantCell.UnregisteredComponents.Add(Component);
+			}
+		});
+	}
+}
+
+void FWorldGridStreamDormancy::MakeActive(const FInt64Vector& InGridIndex)
+{
+	FDormantCell DormantCell;
+	if (false == DormantCells.RemoveAndCopyValue(InGridIndex, DormantCell))
+	{
+		return;
+	}
+
+	for (const TWeakObjectPtr<UActorComponent>& WeakComponent : DormantCell.UnregisteredComponents)
+	{
+		if (UActorComponent* Component = WeakComponent.Get())
+		{
+			Component->RegisterComponent();
+		}
+	}
+	for (const FDormantActor& DormantActor : DormantCell.Actors)
+	{
+		if (AActor* Actor = DormantActor.Actor.Get())
+		{
+			Actor->SetActorHiddenInGame(DormantActor.bWasHidden);
+			Actor->SetActorEnableCollision(DormantActor.bHadCollision);
+		}
+	}
+	for (const TWeakObjectPtr<UObject>& WeakObject : DormantCell.TickDisabledObjects)
+	{
+		if (AActor* Actor = Cast<AActor>(WeakObject.Get()))
+		{
+			Actor->SetActorTickEnabled(true);
+		}
+		else if (UActorComponent* Component = Cast<UActorComponent>(WeakObject.Get()))
+		{
+			Component->SetComponentTickEnabled(true);
+		}
+	}
+}
+
+END_FUNCTION_BUILD_OPTIMIZATION
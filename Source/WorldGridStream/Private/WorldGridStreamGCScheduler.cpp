@@ -0,0 +1,80 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldGridStreamGCScheduler.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/GarbageCollection.h"
+
+#include "WorldGridStreamPrivate.h"
+#include "WorldGridStreamConfigs.h"
+
+BEGIN_FUNCTION_BUILD_OPTIMIZATION
+
+void FWorldGridStreamGCScheduler::AddDebt(int32 NumObjects)
+{
+	UnloadedObjectDebt += FMath::Max(NumObjects, 0);
+}
+
+void FWorldGridStreamGCScheduler::Tick(const UWorldGridStreamConfigs& Configs, float DeltaTime)
+{
+	const double TimeLimit = Configs.GetGCTimeBudgetSeconds();
+	if (true == bCollecting)
+	{
+		if (true == IsIncrementalReachabilityAnalysisPending())
+		{
+			PerformIncrementalReachabilityAnalysis(TimeLimit);
+		}
+		else if (true == IsIncrementalPurgePending())
+		{
+			IncrementalPurgeGarbage(true, TimeLimit);
+		}
+		bCollecting = IsIncrementalReachabilityAnalysisPending() || IsIncrementalPurgePending();
+		return;
+	}
+
+	if (UnloadedObjectDebt <= 0)
+	{
+		return;
+	}
+
+	// The debt keeps aging while cells materialize, the collection starts in the next gap between cells.
+	// A moving player may never leave one, debt older than GCMaxDebtSeconds is collected regardless
+	DebtSeconds += DeltaTime;
+	const bool bDebtExpired = DebtSeconds >= Configs.GetGCMaxDebtSeconds();
+	if (true == IsMaterializing() && false == bDebtExpired)
+	{
+		return;
+	}
+	if (UnloadedObjectDebt < Configs.GetGCDebtThreshold() && false == bDebtExpired)
+	{
+		return;
+	}
+
+	// The engine is already collecting, its collection pays the debt as well
+	if (true == IsGarbageCollecting() || true == IsIncrementalReachabilityAnalysisPending() || true == IsIncrementalPurgePending())
+	{
+		UnloadedObjectDebt = 0;
+		DebtSeconds = 0.0f;
+		return;
+	}
+
+	// Reachability is only incremental with gc.AllowIncrementalReachability=1, otherwise it is one pass and only the purge is sliced
+	UE_LOG(LogWGS, Verbose, TEXT("GC Scheduled - Unloaded object debt: %d, Waited: %.1fs"), UnloadedObjectDebt, DebtSeconds);
+	if (true == TryCollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, false))
+	{
+		UnloadedObjectDebt = 0;
+		DebtSeconds = 0.0f;
+		++CollectionCount;
+		bCollecting = IsIncrementalReachabilityAnalysisPending() || IsIncrementalPurgePending();
+	}
+}
+
+void FWorldGridStreamGCScheduler::Reset()
+{
+	UnloadedObjectDebt = 0;
+	DebtSeconds = 0.0f;
+	MaterializingCells = 0;
+	bCollecting = false;
+	CollectionCount = 0;
+}
+
+END_FUNCTION_BUILD_OPTIMIZATION
@@ -3,14 +3,17 @@
 #include "WorldGridStreamHelpers.h"
 #include "WorldGridStreamPrivate.h"
 #include "Commandlets/Commandlet.h"
+#include "WorldGridStreamConfigs.h"
 
 
 bool FWorldGridStreamHelpers::HasExceededMaxMemory()
 {
 	const FPlatformMemoryStats MemStats = FPlatformMemory::GetStats();
 
-	const uint64 MemoryMinFreePhysical = 1llu * 1024 * 1024 * 1024;
-	const uint64 MemoryMaxUsedPhysical = FMath::Max(32llu * 1024 * 1024 * 1024, MemStats.TotalPhysical / 2);
+	// Per platform in <Platform>WorldGridStreamConfigs.ini, defaults are 1GB min free and max(32GB, TotalPhysical / 2) max used
+	const UWorldGridStreamConfigs* WorldGridStreamConfigs = GetDefault<UWorldGridStreamConfigs>();
+	const uint64 MemoryMinFreePhysical = WorldGridStreamConfigs->GetMinFreePhysicalBytes();
+	const uint64 MemoryMaxUsedPhysical = WorldGridStreamConfigs->GetMaxUsedPhysicalBytes(MemStats.TotalPhysical);
 
 	const bool bHasExceededMinFreePhysical = MemStats.AvailablePhysical < MemoryMinFreePhysical;
 	const bool bHasExceededMaxUsedPhysical = MemStats.UsedPhysical >= MemoryMaxUsedPhysical;
@@ -36,6 +39,22 @@ void FWorldGridStreamHelpers::DoCollectGarbage()
 	);
 }
 
+FName FWorldGridStreamHelpers::GetRingLLMTagName(int32 InRing)
+{
+	// A fixed set of tags built once, one tag per cell would be unbounded in large worlds
+	constexpr int32 NumRingTags = 8;
+	static const TArray<FName> RingTagNames = []()
+	{
+		TArray<FName> Names;
+		for (int32 Ring = 0; Ring < NumRingTags; ++Ring)
+		{
+			Names.Add(FName(*FString::Printf(Ring < NumRingTags - 1 ? TEXT("WorldGridStream/Ring%d") : TEXT("WorldGridStream/Ring%d+"), Ring)));
+		}
+		return Names;
+	}();
+	return RingTagNames[FMath::Clamp(InRing, 0, NumRingTags - 1)];
+}
+
 void FWorldGridStreamHelpers::FakeEngineTick(UWorld* InWorld)
 {
 	check(InWorld);
@@ -4,6 +4,11 @@
 
 #include "WorldGridStreamInstances.h"
 #include "WorldGridStreamInstancesActor.h"
+#include "WorldGridStreamSubsystem.h"
+#include "WorldGridStreamHashHelpers.h"
+#include "WorldGridStreamConfigs.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/GarbageCollection.h"
 
 BEGIN_FUNCTION_BUILD_OPTIMIZATION
 
@@ -17,6 +22,43 @@ UWorldGridStreamInstances::~UWorldGridStreamInstances()
 
 }
 
+bool UWorldGridStreamInstances::CanBeClusterRoot() const
+{
+	// Cooked cells only, in the editor the actors stay mutable
+	return FPlatformProperties::RequiresCookedData() && GCreateGCClusters && GetDefault<UWorldGridStreamConfigs>()->IsCellClusteringEnabled();
+}
+
+void UWorldGridStreamInstances::CreateCellCluster()
+{
+	if (true == CanBeClusterRoot() && false == HasAnyInternalFlags(EInternalObjectFlags::ClusterRoot) && GUObjectArray.ObjectToObjectItem(this)->GetOwnerIndex() == 0)
+	{
+		CreateCluster();
+	}
+}
+
+void UWorldGridStreamInstances::DissolveCellCluster()
+{
+	if (true == HasAnyInternalFlags(EInternalObjectFlags::ClusterRoot))
+	{
+		GUObjectClusters.DissolveCluster(this);
+	}
+}
+
+
+uint64 UWorldGridStreamInstances::GetActorClassKey(const FString& InActorName)
+{
+	return FWorldGridStreamHashHelpers::StrCrc32(*InActorName);
+}
+
+FString UWorldGridStreamInstances::GetInstancesObjectName(const FString& InMapName, const FInt64Vector& InGridIndex)
+{
+	return FString::Printf(TEXT("%s_%s"), *InMapName, *InGridIndex.ToString());
+}
+
+FString UWorldGridStreamInstances::GetInstancesPackageName(const FString& InMapName, const FInt64Vector& InGridIndex)
+{
+	return FString::Printf(TEXT("/Game/WorldGridStream/%s"), *GetInstancesObjectName(InMapName, InGridIndex));
+}
 
 UWorldGridStreamInstances* UWorldGridStreamInstances::FindInstances(UWorld* InWorld, const FInt64Vector& InGridIndex)
 {
@@ -24,11 +66,13 @@ UWorldGridStreamInstances* UWorldGridStreamInstances::FindInstances(UWorld* InWo
 	{
 		return nullptr;
 	}
-	UWorldGridStreamInstances* WorldGridStreamInstances = nullptr;
+	if (UWorldGridStreamSubsystem* WorldGridStreamSubsystem = InWorld->GetSubsystem<UWorldGridStreamSubsystem>())
+	{
+		return WorldGridStreamSubsystem->GetStreamingContext().FindInstances(InGridIndex);
+	}
 
 	AWorldGridStreamInstancesActor* WorldGridStreamInstancesActor = AWorldGridStreamInstancesActor::GetWorldGridStreamInstancesActor(InWorld);
-	WorldGridStreamInstances = WorldGridStreamInstancesActor->WorldGridStreamInstancesMap.FindRef(InGridIndex);
-	return WorldGridStreamInstances;
+	return nullptr != WorldGridStreamInstancesActor ? WorldGridStreamInstancesActor->WorldGridStreamInstancesMap.FindRef(InGridIndex).Get() : nullptr;
 }
 
 UWorldGridStreamInstances* UWorldGridStreamInstances::FindOrCreateInstances(UWorld* InWorld, const FInt64Vector& InGridIndex)
@@ -39,14 +83,19 @@ UWorldGridStreamInstances* UWorldGridStreamInstances::FindOrCreateInstances(UWor
 	}
 	UWorldGridStreamInstances* WorldGridStreamInstances = nullptr;
 	
-	AWorldGridStreamInstancesActor* WorldGridStreamInstancesActor = AWorldGridStreamInstancesActor::GetWorldGridStreamInstancesActor(InWorld);
+	UWorldGridStreamSubsystem* WorldGridStreamSubsystem = InWorld->GetSubsystem<UWorldGridStreamSubsystem>();
+	AWorldGridStreamInstancesActor* WorldGridStreamInstancesActor = nullptr != WorldGridStreamSubsystem ? WorldGridStreamSubsystem->GetStreamingContext().GetInstancesActor() : AWorldGridStreamInstancesActor::GetWorldGridStreamInstancesActor(InWorld);
+	if (nullptr == WorldGridStreamInstancesActor)
+	{
+		return nullptr;
+	}
 	WorldGridStreamInstances = WorldGridStreamInstancesActor->WorldGridStreamInstancesMap.FindRef(InGridIndex);
 
 	if (nullptr == WorldGridStreamInstances)
 	{
 		const FString MapName = InWorld->GetMapName();
-		const FString InstancesObjectName = FString::Printf(TEXT("%s_%s"), *MapName, *InGridIndex.ToString());
-		const FString PackageName = FString::Printf(TEXT("/Game/WorldGridStream/%s"), *InstancesObjectName);
+		const FString InstancesObjectName = GetInstancesObjectName(MapName, InGridIndex);
+		const FString PackageName = GetInstancesPackageName(MapName, InGridIndex);
 		UPackage* Package = CreatePackage(*PackageName);
 		WorldGridStreamInstances = NewObject<UWorldGridStreamInstances>(Package, *InstancesObjectName, RF_Public | RF_Transactional | RF_Standalone);
 		WorldGridStreamInstancesActor->Modify(false);
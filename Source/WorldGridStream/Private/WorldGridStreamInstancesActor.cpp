@@ -37,24 +37,6 @@ void AWorldGridStreamInstancesActor::Serialize(FArchive& Ar)
 	}
 }
 
-void AWorldGridStreamInstancesActor::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
-{
-	Super::AddReferencedObjects(InThis, Collector);
-
-    AWorldGridStreamInstancesActor* This = CastChecked<AWorldGridStreamInstancesActor>(InThis);
-    for (auto WorldGridStreamInstancesPair : This->WorldGridStreamInstancesMap)
-    {
-        TObjectPtr<UWorldGridStreamInstances> WorldGridStreamInstances = WorldGridStreamInstancesPair.Value;
-        for (AActor* Actor : WorldGridStreamInstances->WorldGridStreamActors)
-        {
-            if (Actor)
-            {
-                This->AddReferencedObjects(Actor, Collector);
-            }
-        }
-    }
-}
-
 AWorldGridStreamInstancesActor* AWorldGridStreamInstancesActor::GetWorldGridStreamInstancesActor(const UWorld* World)
 {
 	AWorldGridStreamInstancesActor* FoundActor = nullptr;
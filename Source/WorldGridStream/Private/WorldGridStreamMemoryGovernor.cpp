@@ -0,0 +1,142 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldGridStreamMemoryGovernor.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "WorldGridStreamPrivate.h"
+#include "WorldGridStreamHelpers.h"
+#include "WorldGridStreamConfigs.h"
+
+BEGIN_FUNCTION_BUILD_OPTIMIZATION
+
+FWorldGridStreamCellMemory FWorldGridStreamMemoryGovernor::MeasureCell(const TArray<AActor*>& Actors)
+{
+	FWorldGridStreamCellMemory Memory;
+	TSet<UObject*> ReferencedAssets;
+	TArray<UObject*> References;
+
+	for (AActor* Actor : Actors)
+	{
+		if (false == ::IsValid(Actor))
+		{
+			continue;
+		}
+
+		Memory.ActorBytes += Actor->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+		References.Reset();
+		FReferenceFinder ActorReferenceFinder(References, nullptr, false, true, false, true);
+		ActorReferenceFinder.FindReferences(Actor);
+		Actor->ForEachComponent(false, [&Memory, &References](UActorComponent* Component)
+		{
+			Memory.ComponentBytes += Component->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+			FReferenceFinder ComponentReferenceFinder(References, nullptr, false, true, false, true);
+			ComponentReferenceFinder.FindReferences(Component);
+		});
+
+		for (UObject* Reference : References)
+		{
+			if (nullptr != Reference && Reference->IsAsset())
+			{
+				ReferencedAssets.Add(Reference);
+			}
+		}
+	}
+
+	for (UObject* Asset : ReferencedAssets)
+	{
+		Memory.AssetBytes += Asset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	}
+	return Memory;
+}
+
+void FWorldGridStreamMemoryGovernor::SetCellMemory(const FInt64Vector& CellIndex, const FWorldGridStreamCellMemory& Memory)
+{
+	if (const FWorldGridStreamCellMemory* Existing = CellMemory.Find(CellIndex))
+	{
+		TrackedBytes -= Existing->GetTotalBytes();
+	}
+	CellMemory.Add(CellIndex, Memory);
+	TrackedBytes += Memory.GetTotalBytes();
+}
+
+void FWorldGridStreamMemoryGovernor::RemoveCell(const FInt64Vector& CellIndex)
+{
+	FWorldGridStreamCellMemory Memory;
+	if (CellMemory.RemoveAndCopyValue(CellIndex, Memory))
+	{
+		TrackedBytes -= Memory.GetTotalBytes();
+	}
+}
+
+int64 FWorldGridStreamMemoryGovernor::GetBytesOverBudget(const UWorldGridStreamConfigs& Configs) const
+{
+	const int64 BudgetBytes = Configs.GetCellMemoryBudgetMB() * 1024ll * 1024ll;
+	return BudgetBytes > 0 ? FMath::Max<int64>(TrackedBytes - BudgetBytes, 0) : 0;
+}
+
+bool FWorldGridStreamMemoryGovernor::UpdatePressure(const UWorldGridStreamConfigs& Configs, float DeltaTime)
+{
+	bUnderPressure = GetBytesOverBudget(Configs) > 0 || FWorldGridStreamHelpers::HasExceededMaxMemory();
+	if (true == bUnderPressure)
+	{
+		// One step per governor update while pressure persists
+		TimeWithoutPressure = 0.0f;
+		RadiusScale = FMath::Max(RadiusScale - Configs.GetRadiusShrinkStep(), Configs.GetMinRadiusScale());
+	}
+	else if (RadiusScale < 1.0f)
+	{
+		TimeWithoutPressure += DeltaTime;
+		if (TimeWithoutPressure >= Configs.GetPressureRecoverySeconds())
+		{
+			TimeWithoutPressure = 0.0f;
+			RadiusScale = FMath::Min(RadiusScale + Configs.GetRadiusShrinkStep(), 1.0f);
+		}
+	}
+	return bUnderPressure;
+}
+
+void FWorldGridStreamMemoryGovernor::GatherEvictions(TFunctionRef<double(const FInt64Vector&)> GetCellDistance, double ProtectedDistance, int64 BytesToFree, int32 MaxCells, TArray<FInt64Vector>& OutCells) const
+{
+	TArray<TPair<double, FInt64Vector>> Candidates;
+	Candidates.Reserve(CellMemory.Num());
+	for (const TPair<FInt64Vector, FWorldGridStreamCellMemory>& Pair : CellMemory)
+	{
+		const double Distance = GetCellDistance(Pair.Key);
+		if (Distance > ProtectedDistance)
+		{
+			Candidates.Emplace(Distance, Pair.Key);
+		}
+	}
+	Candidates.Sort([](const TPair<double, FInt64Vector>& A, const TPair<double, FInt64Vector>& B)
+	{
+		return A.Key > B.Key;
+	});
+
+	// Platform pressure has no byte target, BytesToFree <= 0 takes MaxCells
+	int64 FreedBytes = 0;
+	for (int32 Index = 0; Index < Candidates.Num() && OutCells.Num() < MaxCells; ++Index)
+	{
+		if (BytesToFree > 0 && FreedBytes >= BytesToFree)
+		{
+			break;
+		}
+		OutCells.Add(Candidates[Index].Value);
+		FreedBytes += CellMemory.FindChecked(Candidates[Index].Value).GetTotalBytes();
+	}
+}
+
+void FWorldGridStreamMemoryGovernor::Reset()
+{
+	CellMemory.Empty();
+	TrackedBytes = 0;
+	RadiusScale = 1.0f;
+	TimeWithoutPressure = 0.0f;
+	bUnderPressure = false;
+	EvictionCount = 0;
+}
+
+END_FUNCTION_BUILD_OPTIMIZATION
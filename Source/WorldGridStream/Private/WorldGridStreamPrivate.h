@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Stats/Stats.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "WorldGridStreamHelpers.h"
 
 
 DECLARE_LOG_CATEGORY_EXTERN(LogWGS, Log, All);
@@ -11,4 +13,13 @@ DECLARE_LOG_CATEGORY_EXTERN(LogWGS, Log, All);
 /**
  * WorldGirdStream Stats
  */
-DECLARE_STATS_GROUP(TEXT("WorldGirdStream"), STATGROUP_WorldGridStream, STATCAT_Advanced);
\ No newline at end of file
+DECLARE_STATS_GROUP(TEXT("WorldGirdStream"), STATGROUP_WorldGridStream, STATCAT_Advanced);
+
+/**
+ * Attributes the allocations of the enclosing scope to the distance ring of a cell, shows up as WorldGridStream/RingN in LLM
+ */
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+#define WGS_LLM_SCOPE_RING(Ring) FLLMScope PREPROCESSOR_JOIN(WGSRingLLMScope, __LINE__)(FWorldGridStreamHelpers::GetRingLLMTagName(Ring), false, ELLMTagSet::None, ELLMTracker::Default)
+#else
+#define WGS_LLM_SCOPE_RING(Ring)
+#endif
\ No newline at end of file
@@ -0,0 +1,168 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldGridStreamRegistrationPasses.h"
+#include "GameFramework/Actor.h"
+#include "Components/PrimitiveComponent.h"
+
+#include "WorldGridStreamPrivate.h"
+
+BEGIN_FUNCTION_BUILD_OPTIMIZATION
+
+const TCHAR* LexToString(EWorldGridStreamRegistrationPass InPass)
+{
+	switch (InPass)
+	{
+	case EWorldGridStreamRegistrationPass::Render:		return TEXT("Render");
+	case EWorldGridStreamRegistrationPass::Collision:	return TEXT("Collision");
+	case EWorldGridStreamRegistrationPass::Navigation:	return TEXT("Navigation");
+	default:											return TEXT("Invalid");
+	}
+}
+
+bool FWorldGridStreamRegistrationPasses::FCellPasses::IsDone() const
+{
+	for (int32 PassIndex = 0; PassIndex < static_cast<int32>(EWorldGridStreamRegistrationPass::Num); ++PassIndex)
+	{
+		if (NextComponent[PassIndex] < Components.Num())
+		{
+			return false;
+		}
+	}
+	return bSpawned;
+}
+
+void FWorldGridStreamRegistrationPasses::DeferComponents(AActor* InActor, TArray<FWorldGridStreamDeferredComponent>& OutComponents)
+{
+	// Components are not registered yet, the setters only store the values
+	InActor->ForEachComponent<UPrimitiveComponent>(false, [&OutComponents](UPrimitiveComponent* Component)
+	{
+		FWorldGridStreamDeferredComponent& Deferred = OutComponents.AddDefaulted_GetRef();
+		Deferred.Component = Component;
+		Deferred.bHiddenInGame = Component->bHiddenInGame;
+		Deferred.CollisionEnabled = Component->GetCollisionEnabled();
+		Deferred.bCanEverAffectNavigation = Component->CanEverAffectNavigation();
+
+		Component->SetHiddenInGame(true);
+		Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Component->SetCanEverAffectNavigation(false);
+	});
+}
+
+FWorldGridStreamRegistrationPasses::FCellPasses& FWorldGridStreamRegistrationPasses::FindOrAddCell(const FInt64Vector& InGridIndex)
+{
+	if (FCellPasses* CellPasses = Cells.FindByPredicate([&InGridIndex](const FCellPasses& Cell) { return Cell.GridIndex == InGridIndex; }))
+	{
+		return *CellPasses;
+	}
+	FCellPasses& CellPasses = Cells.AddDefaulted_GetRef();
+	CellPasses.GridIndex = InGridIndex;
+	return CellPasses;
+}
+
+void FWorldGridStreamRegistrationPasses::AddComponents(const FInt64Vector& InGridIndex, TArray<FWorldGridStreamDeferredComponent>& InComponents)
+{
+	FindOrAddCell(InGridIndex).Components.Append(MoveTemp(InComponents));
+	InComponents.Reset();
+}
+
+void FWorldGridStreamRegistrationPasses::MarkSpawned(const FInt64Vector& InGridIndex)
+{
+	FindOrAddCell(InGridIndex).bSpawned = true;
+}
+
+void FWorldGridStreamRegistrationPasses::Cancel(const FInt64Vector& InGridIndex)
+{
+	Cells.RemoveAll([&InGridIndex](const FCellPasses& Cell) { return Cell.GridIndex == InGridIndex; });
+}
+
+int32 FWorldGridStreamRegistrationPasses::GetNumPending(EWorldGridStreamRegistrationPass InPass) const
+{
+	int32 NumPending = 0;
+	for (const FCellPasses& Cell : Cells)
+	{
+		NumPending += Cell.Components.Num() - Cell.NextComponent[static_cast<int32>(InPass)];
+	}
+	return NumPending;
+}
+
+void FWorldGridStreamRegistrationPasses::Tick(const double (&InBudgetSeconds)[static_cast<int32>(EWorldGridStreamRegistrationPass::Num)], TFunctionRef<double(const FInt64Vector&)> GetCellDistance, TFunctionRef<int32(const FInt64Vector&)> GetCellRing, TArray<FInt64Vector>& OutRegisteredCells)
+{
+	if (Cells.Num() == 0)
+	{
+		return;
+	}
+
+	Cells.Sort([&GetCellDistance](const FCellPasses& A, const FCellPasses& B)
+	{
+		return GetCellDistance(A.GridIndex) < GetCellDistance(B.GridIndex);
+	});
+
+	for (int32 PassIndex = 0; PassIndex < static_cast<int32>(EWorldGridStreamRegistrationPass::Num); ++PassIndex)
+	{
+		const EWorldGridStreamRegistrationPass Pass = static_cast<EWorldGridStreamRegistrationPass>(PassIndex);
+		const double EndTime = FPlatformTime::Seconds() + InBudgetSeconds[PassIndex];
+		bool bBudgetSpent = false;
+		for (int32 CellIndex = 0; CellIndex < Cells.Num() && false == bBudgetSpent; ++CellIndex)
+		{
+			FCellPasses& Cell = Cells[CellIndex];
+			WGS_LLM_SCOPE_RING(GetCellRing(Cell.GridIndex));
+			while (Cell.NextComponent[PassIndex] < Cell.Components.Num())
+			{
+				RunPass(Pass, Cell.Components[Cell.NextComponent[PassIndex]++]);
+				if (FPlatformTime::Seconds() >= EndTime)
+				{
+					bBudgetSpent = true;
+					break;
+				}
+			}
+		}
+	}
+
+	for (int32 CellIndex = Cells.Num() - 1; CellIndex >= 0; --CellIndex)
+	{
+		if (true == Cells[CellIndex].IsDone())
+		{
+			OutRegisteredCells.Add(Cells[CellIndex].GridIndex);
+			Cells.RemoveAt(CellIndex, EAllowShrinking::No);
+		}
+	}
+}
+
+void FWorldGridStreamRegistrationPasses::RunPass(EWorldGridStreamRegistrationPass InPass, const FWorldGridStreamDeferredComponent& InDeferred)
+{
+	UPrimitiveComponent* Component = InDeferred.Component.Get();
+	if (nullptr == Component)
+	{
+		return;
+	}
+
+	// BeginPlay ran before the passes, a value it changed is no longer the one DeferComponents set and is kept
+	switch (InPass)
+	{
+	case EWorldGridStreamRegistrationPass::Render:
+		// Adds the primitive to the scene
+		if (false == InDeferred.bHiddenInGame && true == Component->bHiddenInGame)
+		{
+			Component->SetHiddenInGame(false);
+		}
+		break;
+	case EWorldGridStreamRegistrationPass::Collision:
+		// Creates the physics state
+		if (InDeferred.CollisionEnabled != ECollisionEnabled::NoCollision && Component->GetCollisionEnabled() == ECollisionEnabled::NoCollision)
+		{
+			Component->SetCollisionEnabled(InDeferred.CollisionEnabled);
+		}
+		break;
+	case EWorldGridStreamRegistrationPass::Navigation:
+		// Registers to the navigation octree
+		if (true == InDeferred.bCanEverAffectNavigation && false == Component->CanEverAffectNavigation())
+		{
+			Component->SetCanEverAffectNavigation(true);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+END_FUNCTION_BUILD_OPTIMIZATION
@@ -12,6 +12,9 @@ AWorldGridStreamSettings::AWorldGridStreamSettings(const FObjectInitializer& Obj
 	: Super(ObjectInitializer.DoNotCreateDefaultSubobject(TEXT("Sprite")))
 	, bIncludeZDistance(false)
 	, bStreamingOn(true)
+	, DormantDistanceScale(2.0f)
+	, bUnregisterDormantComponents(false)
+	, CollisionDistanceScale(0.5f)
 	, WorldScale(100.0f)
 #if WITH_EDITORONLY_DATA
 	, DivideDistancePowerOfTwo(EPowerOfTwo::Power256)
@@ -0,0 +1,145 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldGridStreamSpawnPipeline.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Components/SceneComponent.h"
+#include "UObject/GarbageCollection.h"
+
+#include "WorldGridStreamPrivate.h"
+#include "WorldGridStreamInstances.h"
+
+BEGIN_FUNCTION_BUILD_OPTIMIZATION
+
+void FWorldGridStreamSpawnPipeline::Enqueue(const FInt64Vector& InGridIndex, UWorldGridStreamInstances* InInstances)
+{
+	TSharedRef<FCellSpawn> CellSpawn = MakeShared<FCellSpawn>();
+	CellSpawn->GridIndex = InGridIndex;
+	CellSpawn->Instances = InInstances;
+	CellSpawn->PrepTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [CellSpawn]()
+	{
+		// The templates are only read, GC must not run meanwhile
+		FGCScopeGuard GCScopeGuard;
+		const UWorldGridStreamInstances* WorldGridStreamInstances = CellSpawn->Instances.Get();
+		if (nullptr == WorldGridStreamInstances)
+		{
+			return;
+		}
+
+		CellSpawn->Preps.Reserve(WorldGridStreamInstances->WorldGridStreamActors.Num());
+		for (AActor* Template : WorldGridStreamInstances->WorldGridStreamActors)
+		{
+			if (nullptr == Template)
+			{
+				continue;
+			}
+
+			FWorldGridStreamSpawnPrep& Prep = CellSpawn->Preps.AddDefaulted_GetRef();
+			Prep.Template = Template;
+			UClass* ActorClass = WorldGridStreamInstances->ActorClassMaps.FindRef(UWorldGridStreamInstances::GetActorClassKey(Template->GetName()));
+			Prep.ActorClass = nullptr != ActorClass ? ActorClass : Template->GetClass();
+			if (const USceneComponent* RootComponent = Template->GetRootComponent())
+			{
+				// ComponentToWorld is not serialized, it is only valid for templates registered in a world.
+				// The relative transform is the world transform of an unattached root
+				Prep.Transform = nullptr != Template->GetWorld() ? RootComponent->GetComponentTransform() : RootComponent->GetRelativeTransform();
+			}
+		}
+	});
+	Cells.Add(CellSpawn);
+}
+
+bool FWorldGridStreamSpawnPipeline::Cancel(const FInt64Vector& InGridIndex)
+{
+	// A running preparation keeps its FCellSpawn alive until it returns
+	return Cells.RemoveAll([&InGridIndex](const TSharedRef<FCellSpawn>& CellSpawn) { return CellSpawn->GridIndex == InGridIndex; }) > 0;
+}
+
+bool FWorldGridStreamSpawnPipeline::Contains(const FInt64Vector& InGridIndex) const
+{
+	return Cells.ContainsByPredicate([&InGridIndex](const TSharedRef<FCellSpawn>& CellSpawn) { return CellSpawn->GridIndex == InGridIndex; });
+}
+
+void FWorldGridStreamSpawnPipeline::Tick(UWorld* InWorld, double InBudgetSeconds, TFunctionRef<double(const FInt64Vector&)> GetCellDistance, TFunctionRef<int32(const FInt64Vector&)> GetCellRing, TFunctionRef<void(const FInt64Vector&, AActor*)> OnActorSpawned, FWorldGridStreamRegistrationPasses& InRegistrationPasses, TArray<FInt64Vector>& OutSpawnedCells)
+{
+	if (Cells.Num() == 0)
+	{
+		return;
+	}
+
+	Cells.Sort([&GetCellDistance](const TSharedRef<FCellSpawn>& A, const TSharedRef<FCellSpawn>& B)
+	{
+		return GetCellDistance(A->GridIndex) < GetCellDistance(B->GridIndex);
+	});
+
+	const double EndTime = FPlatformTime::Seconds() + InBudgetSeconds;
+	bool bBudgetSpent = false;
+	TArray<FWorldGridStreamDeferredComponent> DeferredComponents;
+	for (int32 CellIndex = 0; CellIndex < Cells.Num() && false == bBudgetSpent; )
+	{
+		FCellSpawn& CellSpawn = Cells[CellIndex].Get();
+		if (false == CellSpawn.PrepTask.IsCompleted())
+		{
+			++CellIndex;
+			continue;
+		}
+
+		UWorldGridStreamInstances* WorldGridStreamInstances = CellSpawn.Instances.Get();
+		WGS_LLM_SCOPE_RING(GetCellRing(CellSpawn.GridIndex));
+		while (nullptr != WorldGridStreamInstances && CellSpawn.NextPrep < CellSpawn.Preps.Num())
+		{
+			const FWorldGridStreamSpawnPrep& Prep = CellSpawn.Preps[CellSpawn.NextPrep++];
+			AActor* Template = Prep.Template.Get();
+			UClass* ActorClass = Prep.ActorClass.Get();
+			if (nullptr != ActorClass)
+			{
+				FActorSpawnParameters SpawnParameters;
+				SpawnParameters.Template = nullptr != Template && Template->GetClass() == ActorClass ? Template : nullptr;
+				SpawnParameters.bDeferConstruction = true;
+				SpawnParameters.ObjectFlags = RF_Transient;
+				SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+				SpawnParameters.CustomPreSpawnInitalization = [&DeferredComponents](AActor* Actor)
+				{
+					// Every machine streams its own copy of the cell, a listen server's must not reach the clients as well
+					Actor->SetReplicates(false);
+					FWorldGridStreamRegistrationPasses::DeferComponents(Actor, DeferredComponents);
+				};
+				if (AActor* Actor = InWorld->SpawnActor(ActorClass, &Prep.Transform, SpawnParameters))
+				{
+					Actor->FinishSpawning(Prep.Transform);
+					OnActorSpawned(CellSpawn.GridIndex, Actor);
+					InRegistrationPasses.AddComponents(CellSpawn.GridIndex, DeferredComponents);
+				}
+				DeferredComponents.Reset();
+			}
+
+			if (FPlatformTime::Seconds() >= EndTime)
+			{
+				bBudgetSpent = true;
+				break;
+			}
+		}
+
+		if (nullptr == WorldGridStreamInstances || CellSpawn.NextPrep >= CellSpawn.Preps.Num())
+		{
+			InRegistrationPasses.MarkSpawned(CellSpawn.GridIndex);
+			OutSpawnedCells.Add(CellSpawn.GridIndex);
+			Cells.RemoveAt(CellIndex, EAllowShrinking::No);
+		}
+		else
+		{
+			++CellIndex;
+		}
+	}
+}
+
+void FWorldGridStreamSpawnPipeline::Reset()
+{
+	for (const TSharedRef<FCellSpawn>& CellSpawn : Cells)
+	{
+		CellSpawn->PrepTask.Wait();
+	}
+	Cells.Empty();
+}
+
+END_FUNCTION_BUILD_OPTIMIZATION
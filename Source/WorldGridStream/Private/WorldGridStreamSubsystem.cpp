@@ -15,12 +15,56 @@
 #endif //WITH_EDITOR
 #include "LandscapeProxy.h"
 
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
 #include "WorldGridStreamSettings.h"
+#include "WorldGridStreamConfigs.h"
+#include "WorldGridStreamInstances.h"
 #include "WorldGridStreamInstancesActor.h"
+#include "WorldGridStreamMathHelpers.h"
 
 #define LOCTEXT_NAMESPACE "WorldGridStreamSubsystem"
 
 DECLARE_CYCLE_STAT(TEXT("WorldGridStreamSubsystem Tick"), STAT_WGSSubsystemTick, STATGROUP_WorldGridStream);
+DECLARE_CYCLE_STAT(TEXT("WorldGridStream Memory Governor"), STAT_WGSMemoryGovernor, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tracked Cells"), STAT_WGSTrackedCells, STATGROUP_WorldGridStream);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Tracked Cell MB (estimated)"), STAT_WGSTrackedCellMB, STATGROUP_WorldGridStream);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Streaming Radius Scale"), STAT_WGSRadiusScale, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Memory Evictions"), STAT_WGSMemoryEvictions, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("GC Unloaded Object Debt"), STAT_WGSGCDebt, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cell Package Loads In Flight"), STAT_WGSCellLoadsInFlight, STATGROUP_WorldGridStream);
+DECLARE_CYCLE_STAT(TEXT("WorldGridStream Spawn Actors"), STAT_WGSSpawnActors, STATGROUP_WorldGridStream);
+DECLARE_CYCLE_STAT(TEXT("WorldGridStream Destroy Actors"), STAT_WGSDestroyActors, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pending Actor Destructions"), STAT_WGSPendingDestroyActors, STATGROUP_WorldGridStream);
+DECLARE_CYCLE_STAT(TEXT("WorldGridStream Component Registration"), STAT_WGSComponentRegistration, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pending Render Registrations"), STAT_WGSPendingRenderRegistrations, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pending Collision Registrations"), STAT_WGSPendingCollisionRegistrations, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pending Navigation Registrations"), STAT_WGSPendingNavigationRegistrations, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tick Suspended Objects"), STAT_WGSTickSuspended, STATGROUP_WorldGridStream);
+DECLARE_CYCLE_STAT(TEXT("WorldGridStream Collision Streaming"), STAT_WGSCollisionStreaming, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Collision Disabled Cells"), STAT_WGSCollisionDisabledCells, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cells Requested"), STAT_WGSCellsRequested, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cells Loading"), STAT_WGSCellsLoading, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cells Loaded"), STAT_WGSCellsLoaded, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cells Activating"), STAT_WGSCellsActivating, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cells Active"), STAT_WGSCellsActive, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cells Dormant"), STAT_WGSCellsDormant, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cells Deactivating"), STAT_WGSCellsDeactivating, STATGROUP_WorldGridStream);
+DECLARE_DWORD_COUNTER_STAT(TEXT("GC Scheduled Collections"), STAT_WGSGCCollections, STATGROUP_WorldGridStream);
+
+static FAutoConsoleCommandWithWorldAndArgs CmdDumpCellStates(
+	TEXT("wgs.DumpCellStates"),
+	TEXT("Logs the number of cells in each state and the time cells spent in it"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UWorldGridStreamSubsystem* WorldGridStreamSubsystem = nullptr != World ? World->GetSubsystem<UWorldGridStreamSubsystem>() : nullptr)
+		{
+			WorldGridStreamSubsystem->GetStreamingContext().DumpStates(*GLog);
+		}
+	}));
 
 BEGIN_FUNCTION_BUILD_OPTIMIZATION
 
@@ -40,6 +84,8 @@ void UWorldGridStreamSubsystem::PostInitProperties()
 void UWorldGridStreamSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
+
+	StreamingContext.Initialize(GetWorld());
     
 	const FOnActorSpawned::FDelegate ActorSpawnedDelegate = FOnActorSpawned::FDelegate::CreateUObject(this, &UWorldGridStreamSubsystem::OnActorSpawned);
     if(UWorld* World = GetWorld())
@@ -57,6 +103,20 @@ void UWorldGridStreamSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 void UWorldGridStreamSubsystem::Deinitialize()
 {
 	Super::Deinitialize();
+
+	SpawnPipeline.Reset();
+	RegistrationPasses.Reset();
+	Dormancy.Reset();
+	TickThrottle.Reset();
+	CollisionStreaming.Reset();
+	MemoryGovernor.Reset();
+	GCScheduler.Reset();
+	StreamingContext.Reset();
+	StreamingSources.Empty();
+	PendingDestroyActors.Empty();
+	NextPendingDestroyActor = 0;
+	CollisionSources.Empty();
+	CollisionGuards.Empty();
     
     if(UWorld* World = GetWorld())
     {
@@ -78,11 +138,79 @@ void UWorldGridStreamSubsystem::Tick(float DeltaTime)
 	LLM_SCOPE_BYNAME(TEXT("WorldGridStreamSubsystem"));
 
 	Super::Tick(DeltaTime);
+
+	UWorld* World = GetWorld();
+	if (nullptr == World || false == World->IsGameWorld() || nullptr == WorldGridStreamSettings || false == WorldGridStreamSettings->bStreamingOn)
+	{
+		return;
+	}
+
+	GatherStreamingSources();
+	GatherTickThrottleSources();
+
+	// Dedicated servers do not stream, their cells are the placed actors mapped at begin play. Only their ticks are throttled around every player
+	if (true == World->IsNetMode(NM_DedicatedServer))
+	{
+		TrackResidentCells();
+		UpdateTickThrottle();
+		return;
+	}
+
+	GatherCollisionSources();
+	UpdateCellStreaming();
+	DestroyPendingActors();
+	UpdateCollisionStreaming();
+	UpdateTickThrottle();
+	UpdateMemoryGovernor(DeltaTime);
+
+	GCScheduler.Tick(*GetDefault<UWorldGridStreamConfigs>(), DeltaTime);
+	SET_DWORD_STAT(STAT_WGSGCDebt, GCScheduler.GetDebt());
+	SET_DWORD_STAT(STAT_WGSGCCollections, GCScheduler.GetCollectionCount());
+	SET_DWORD_STAT(STAT_WGSCellLoadsInFlight, InFlightCellLoads);
+	SET_DWORD_STAT(STAT_WGSCellsRequested, StreamingContext.GetNumCellsInState(EWorldGridStreamCellState::Requested));
+	SET_DWORD_STAT(STAT_WGSCellsLoading, StreamingContext.GetNumCellsInState(EWorldGridStreamCellState::Loading));
+	SET_DWORD_STAT(STAT_WGSCellsLoaded, StreamingContext.GetNumCellsInState(EWorldGridStreamCellState::Loaded));
+	SET_DWORD_STAT(STAT_WGSCellsActivating, StreamingContext.GetNumCellsInState(EWorldGridStreamCellState::Activating));
+	SET_DWORD_STAT(STAT_WGSCellsActive, StreamingContext.GetNumCellsInState(EWorldGridStreamCellState::Active));
+	SET_DWORD_STAT(STAT_WGSCellsDormant, StreamingContext.GetNumCellsInState(EWorldGridStreamCellState::Dormant));
+	SET_DWORD_STAT(STAT_WGSCellsDeactivating, StreamingContext.GetNumCellsInState(EWorldGridStreamCellState::Deactivating));
+}
+
+void UWorldGridStreamSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Settings saved in the map are loaded, not spawned, OnActorSpawned never sees them
+	if (nullptr == WorldGridStreamSettings)
+	{
+		TActorIterator<AWorldGridStreamSettings> It(&InWorld);
+		WorldGridStreamSettings = It ? *It : nullptr;
+	}
+	if (nullptr == WorldGridStreamSettings || false == InWorld.IsGameWorld())
+	{
+		return;
+	}
+
+	// PerModuleDataObjects is not saved with the map, cooked worlds need their own holder of the resident cells
+	if (nullptr == StreamingContext.GetInstancesActor())
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags = RF_Transient;
+		AWorldGridStreamInstancesActor* InstanceActor = InWorld.SpawnActor<AWorldGridStreamInstancesActor>(SpawnParameters);
+		InstanceActor->SetWorld(&InWorld);
+		InWorld.PerModuleDataObjects.Emplace(InstanceActor);
+	}
+	StreamingContext.GatherCellPackages();
+
+	if (true == InWorld.IsNetMode(NM_DedicatedServer))
+	{
+		MapPlacedActors(InWorld);
+	}
 }
 
 ETickableTickType UWorldGridStreamSubsystem::GetTickableTickType() const
 {
-	return HasAnyFlags(RF_ClassDefaultObject) || !GetWorld() || GetWorld()->IsNetMode(NM_DedicatedServer) ? ETickableTickType::Never : ETickableTickType::Always;
+	return HasAnyFlags(RF_ClassDefaultObject) || !GetWorld() ? ETickableTickType::Never : ETickableTickType::Always;
 }
 
 bool UWorldGridStreamSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
@@ -106,6 +234,724 @@ AWorldGridStreamSettings* UWorldGridStreamSubsystem::GetWorldGridStreamSettings(
 	return WorldGridStreamSettings.Get();
 }
 
+double UWorldGridStreamSubsystem::GetEffectiveStreamingRadius() const
+{
+	return nullptr != WorldGridStreamSettings ? WorldGridStreamSettings->VisibilityDistance * MemoryGovernor.GetRadiusScale() : 0.0;
+}
+
+double UWorldGridStreamSubsystem::GetDistanceToCell(const FInt64Vector& InGridIndex) const
+{
+	return GetDistanceToCell(InGridIndex, StreamingSources);
+}
+
+double UWorldGridStreamSubsystem::GetDistanceToCell(const FInt64Vector& InGridIndex, const TArray<FVector>& InSources) const
+{
+	if (nullptr == WorldGridStreamSettings || InSources.Num() == 0)
+	{
+		return 0.0;
+	}
+
+	// Bounds rather than center, a source inside a cell is at distance 0 from it however far the radius shrinks
+	const double GridSize = WorldGridStreamSettings->VisibilityDistance;
+	const FVector CellMin = FVector(InGridIndex.X, InGridIndex.Y, InGridIndex.Z) * GridSize;
+	const FVector CellMax = CellMin + FVector(GridSize);
+	double MinDistanceSquared = TNumericLimits<double>::Max();
+	for (const FVector& Source : InSources)
+	{
+		const FVector Closest = Source.BoundToBox(CellMin, CellMax);
+		const double DistanceSquared = WorldGridStreamSettings->bIncludeZDistance ? FVector::DistSquared(Source, Closest) : FVector::DistSquared2D(Source, Closest);
+		MinDistanceSquared = FMath::Min(MinDistanceSquared, DistanceSquared);
+	}
+	return FMath::Sqrt(MinDistanceSquared);
+}
+
+void UWorldGridStreamSubsystem::RegisterCollisionGuard(AActor* InActor)
+{
+	if (true == ::IsValid(InActor))
+	{
+		CollisionGuards.AddUnique(InActor);
+	}
+}
+
+void UWorldGridStreamSubsystem::UnregisterCollisionGuard(AActor* InActor)
+{
+	CollisionGuards.Remove(InActor);
+}
+
+double UWorldGridStreamSubsystem::GetCollisionDistanceToCell(const FInt64Vector& InGridIndex) const
+{
+	return GetDistanceToCell(InGridIndex, CollisionSources);
+}
+
+int32 UWorldGridStreamSubsystem::GetCellRing(const FInt64Vector& InGridIndex) const
+{
+	const double GridSize = nullptr != WorldGridStreamSettings ? WorldGridStreamSettings->VisibilityDistance : 0.0;
+	return GridSize > 0.0 ? FMath::FloorToInt32(GetDistanceToCell(InGridIndex) / GridSize) : 0;
+}
+
+bool UWorldGridStreamSubsystem::UnloadCell(const FInt64Vector& InGridIndex)
+{
+	UWorld* World = GetWorld();
+	AWorldGridStreamInstancesActor* WorldGridStreamInstancesActor = StreamingContext.GetInstancesActor();
+	if (nullptr == World || nullptr == WorldGridStreamInstancesActor)
+	{
+		return false;
+	}
+
+	TObjectPtr<UWorldGridStreamInstances> WorldGridStreamInstances;
+	if (false == WorldGridStreamInstancesActor->WorldGridStreamInstancesMap.RemoveAndCopyValue(InGridIndex, WorldGridStreamInstances))
+	{
+		return false;
+	}
+	MemoryGovernor.RemoveCell(InGridIndex);
+
+	// Gathered before the cell leaves the context with its spawned actors
+	TArray<AActor*> Actors;
+	StreamingContext.GetCellActors(InGridIndex, Actors);
+
+	const EWorldGridStreamCellState CellState = StreamingContext.GetCellState(InGridIndex);
+	Dormancy.Remove(InGridIndex);
+	TickThrottle.RestoreCell(InGridIndex);
+	CollisionStreaming.Remove(InGridIndex);
+	if (CellState == EWorldGridStreamCellState::Active || CellState == EWorldGridStreamCellState::Activating || CellState == EWorldGridStreamCellState::Dormant)
+	{
+		StreamingContext.SetCellState(InGridIndex, EWorldGridStreamCellState::Deactivating);
+	}
+	if (true == SpawnPipeline.Cancel(InGridIndex))
+	{
+		GCScheduler.EndMaterialization();
+	}
+	RegistrationPasses.Cancel(InGridIndex);
+
+	const int32 NumPendingDestroyActors = PendingDestroyActors.Num();
+	if (nullptr != WorldGridStreamInstances)
+	{
+		WorldGridStreamInstances->DissolveCellCluster();
+
+		// Templates loaded with the cell package are not in the world, only actors placed in the map are destroyed.
+		// Destruction is spread over the next frames by DestroyPendingActors, the cell stays Deactivating until then
+		for (AActor* Actor : Actors)
+		{
+			if (true == ::IsValid(Actor) && Actor->GetWorld() == World)
+			{
+				PendingDestroyActors.Emplace(InGridIndex, Actor);
+			}
+		}
+	}
+
+	if (StreamingContext.GetCellState(InGridIndex) != EWorldGridStreamCellState::Unloaded && PendingDestroyActors.Num() == NumPendingDestroyActors)
+	{
+		StreamingContext.SetCellState(InGridIndex, EWorldGridStreamCellState::Unloaded);
+	}
+	return true;
+}
+
+void UWorldGridStreamSubsystem::ReleaseCell(const FInt64Vector& InGridIndex)
+{
+	switch (StreamingContext.GetCellState(InGridIndex))
+	{
+	case EWorldGridStreamCellState::Requested:
+	case EWorldGridStreamCellState::Loading:
+		// An in-flight package load cannot be aborted, its completion no longer matches the cell and the package is left to GC
+		StreamingContext.SetCellState(InGridIndex, EWorldGridStreamCellState::Unloaded);
+		break;
+	case EWorldGridStreamCellState::Loaded:
+	case EWorldGridStreamCellState::Activating:
+	case EWorldGridStreamCellState::Active:
+	case EWorldGridStreamCellState::Dormant:
+		UnloadCell(InGridIndex);
+		break;
+	default:
+		break;
+	}
+}
+
+void UWorldGridStreamSubsystem::UpdateCellStreaming()
+{
+	if (StreamingSources.Num() == 0 || StreamingContext.GetNumCellPackages() == 0)
+	{
+		return;
+	}
+
+	const UWorldGridStreamConfigs* WorldGridStreamConfigs = GetDefault<UWorldGridStreamConfigs>();
+	const double LoadRadius = GetEffectiveStreamingRadius();
+	const double DormantRadius = WorldGridStreamSettings->GetDormantDistance() * MemoryGovernor.GetRadiusScale();
+	const double UnloadDistanceScale = WorldGridStreamConfigs->GetCellUnloadDistanceScale();
+	for (const FVector& Source : StreamingSources)
+	{
+		RequestCellsAround(Source, LoadRadius);
+	}
+
+	// Active cells leaving the streaming radius go dormant, dormant cells leaving the dormant radius are unloaded
+	TArray<TPair<double, FInt64Vector>> RequestedCells;
+	TArray<FInt64Vector> ReleasedCells;
+	TArray<FInt64Vector> DormantCells;
+	TArray<FInt64Vector> WokenCells;
+	for (const TPair<FInt64Vector, FWorldGridStreamCell>& Pair : StreamingContext.GetCells())
+	{
+		const double Distance = GetDistanceToCell(Pair.Key);
+		const EWorldGridStreamCellState CellState = Pair.Value.State;
+		const bool bResident = CellState == EWorldGridStreamCellState::Active || CellState == EWorldGridStreamCellState::Dormant;
+		if (Distance > (bResident ? DormantRadius : LoadRadius) * UnloadDistanceScale)
+		{
+			ReleasedCells.Add(Pair.Key);
+		}
+		else if (CellState == EWorldGridStreamCellState::Requested)
+		{
+			RequestedCells.Emplace(Distance, Pair.Key);
+		}
+		else if (CellState == EWorldGridStreamCellState::Active && Distance > LoadRadius * UnloadDistanceScale)
+		{
+			DormantCells.Add(Pair.Key);
+		}
+		else if (CellState == EWorldGridStreamCellState::Dormant && Distance <= LoadRadius)
+		{
+			WokenCells.Add(Pair.Key);
+		}
+	}
+	for (const FInt64Vector& GridIndex : ReleasedCells)
+	{
+		ReleaseCell(GridIndex);
+	}
+	for (const FInt64Vector& GridIndex : DormantCells)
+	{
+		if (nullptr != StreamingContext.FindInstances(GridIndex))
+		{
+			TArray<AActor*> Actors;
+			StreamingContext.GetCellActors(GridIndex, Actors);
+			TickThrottle.RestoreCell(GridIndex);
+			Dormancy.MakeDormant(GridIndex, Actors, WorldGridStreamSettings->bUnregisterDormantComponents);
+			StreamingContext.SetCellState(GridIndex, EWorldGridStreamCellState::Dormant);
+		}
+	}
+	for (const FInt64Vector& GridIndex : WokenCells)
+	{
+		Dormancy.MakeActive(GridIndex);
+		StreamingContext.SetCellState(GridIndex, EWorldGridStreamCellState::Active);
+	}
+	EnforceDormantCaps();
+
+	// Nearest first, the rest wait for a free slot
+	RequestedCells.Sort([](const TPair<double, FInt64Vector>& A, const TPair<double, FInt64Vector>& B) { return A.Key < B.Key; });
+	const int32 MaxConcurrentCellLoads = WorldGridStreamConfigs->GetMaxConcurrentCellLoads();
+	for (int32 Index = 0; Index < RequestedCells.Num() && InFlightCellLoads < MaxConcurrentCellLoads; ++Index)
+	{
+		LoadCell(RequestedCells[Index].Value, RequestedCells[Index].Key);
+	}
+
+	ActivateLoadedCells();
+}
+
+void UWorldGridStreamSubsystem::UpdateTickThrottle()
+{
+	const UWorldGridStreamConfigs* WorldGridStreamConfigs = GetDefault<UWorldGridStreamConfigs>();
+	if (false == WorldGridStreamConfigs->ShouldThrottleTicks() || TickThrottleSources.Num() == 0)
+	{
+		return;
+	}
+
+	const double GridSize = WorldGridStreamSettings->VisibilityDistance;
+	const int32 TickStaggerFrames = WorldGridStreamConfigs->GetTickStaggerFrames();
+	TArray<AActor*> Actors;
+	for (const TPair<FInt64Vector, FWorldGridStreamCell>& Pair : StreamingContext.GetCells())
+	{
+		if (Pair.Value.State != EWorldGridStreamCellState::Active)
+		{
+			continue;
+		}
+		// Only the first call for a cell reads its actors
+		Actors.Reset();
+		if (TickThrottle.GetCellRing(Pair.Key) == INDEX_NONE)
+		{
+			StreamingContext.GetCellActors(Pair.Key, Actors);
+		}
+		const int32 Ring = GridSize > 0.0 ? FMath::FloorToInt32(GetDistanceToCell(Pair.Key, TickThrottleSources) / GridSize) : 0;
+		TickThrottle.SetCellRing(Pair.Key, Actors, Ring, TickStaggerFrames);
+	}
+	TickThrottle.Tick(WorldGridStreamConfigs->GetRingTickIntervals());
+	SET_DWORD_STAT(STAT_WGSTickSuspended, TickThrottle.GetNumSuspended());
+}
+
+void UWorldGridStreamSubsystem::DestroyPendingActors()
+{
+	if (NextPendingDestroyActor >= PendingDestroyActors.Num())
+	{
+		return;
+	}
+	SCOPE_CYCLE_COUNTER(STAT_WGSDestroyActors);
+
+	UWorld* World = GetWorld();
+	const double EndTime = FPlatformTime::Seconds() + GetDefault<UWorldGridStreamConfigs>()->GetCellUnloadBudgetSeconds();
+	while (NextPendingDestroyActor < PendingDestroyActors.Num())
+	{
+		const FInt64Vector GridIndex = PendingDestroyActors[NextPendingDestroyActor].Key;
+		// Gameplay may have destroyed it in the meantime
+		AActor* Actor = PendingDestroyActors[NextPendingDestroyActor++].Value.Get();
+		const bool bDestroyed = ::IsValid(Actor);
+		if (true == bDestroyed)
+		{
+			GCScheduler.AddDebt(Actor->GetComponents().Num() + 1);
+			World->DestroyActor(Actor);
+		}
+
+		// The cell leaves Deactivating with its last actor, it can be requested again from there
+		if (NextPendingDestroyActor >= PendingDestroyActors.Num() || PendingDestroyActors[NextPendingDestroyActor].Key != GridIndex)
+		{
+			StreamingContext.SetCellState(GridIndex, EWorldGridStreamCellState::Unloaded);
+		}
+		if (true == bDestroyed && FPlatformTime::Seconds() >= EndTime)
+		{
+			break;
+		}
+	}
+
+	if (NextPendingDestroyActor >= PendingDestroyActors.Num())
+	{
+		PendingDestroyActors.Reset();
+		NextPendingDestroyActor = 0;
+	}
+	SET_DWORD_STAT(STAT_WGSPendingDestroyActors, PendingDestroyActors.Num() - NextPendingDestroyActor);
+}
+
+void UWorldGridStreamSubsystem::UpdateCollisionStreaming()
+{
+	if (false == WorldGridStreamSettings->IsCollisionStreamingEnabled() || CollisionSources.Num() == 0)
+	{
+		return;
+	}
+	SCOPE_CYCLE_COUNTER(STAT_WGSCollisionStreaming);
+
+	// Disabled as soon as a cell leaves the collision radius, enabled nearest first
+	const UWorldGridStreamConfigs* WorldGridStreamConfigs = GetDefault<UWorldGridStreamConfigs>();
+	const double CollisionRadius = WorldGridStreamSettings->GetCollisionDistance();
+	const double DisableRadius = CollisionRadius * WorldGridStreamConfigs->GetCellUnloadDistanceScale();
+	TArray<TPair<double, FInt64Vector>> EnabledCells;
+	for (const TPair<FInt64Vector, FWorldGridStreamCell>& Pair : StreamingContext.GetCells())
+	{
+		// Dormant cells have no collision, they are handled once woken
+		if (Pair.Value.State != EWorldGridStreamCellState::Active && Pair.Value.State != EWorldGridStreamCellState::Activating)
+		{
+			continue;
+		}
+
+		const double Distance = GetCollisionDistanceToCell(Pair.Key);
+		const bool bDisabled = CollisionStreaming.IsCellDisabled(Pair.Key);
+		if (false == bDisabled && Distance > DisableRadius)
+		{
+			if (true == Pair.Value.Instances.IsValid())
+			{
+				TArray<AActor*> Actors;
+				StreamingContext.GetCellActors(Pair.Key, Actors);
+				CollisionStreaming.DisableCell(Pair.Key, Actors);
+			}
+		}
+		else if (true == bDisabled && Distance <= CollisionRadius)
+		{
+			EnabledCells.Emplace(Distance, Pair.Key);
+		}
+	}
+
+	EnabledCells.Sort([](const TPair<double, FInt64Vector>& A, const TPair<double, FInt64Vector>& B) { return A.Key < B.Key; });
+	const double EndTime = FPlatformTime::Seconds() + WorldGridStreamConfigs->GetCollisionEnableBudgetSeconds();
+	for (const TPair<double, FInt64Vector>& EnabledCell : EnabledCells)
+	{
+		CollisionStreaming.EnableCell(EnabledCell.Value);
+		if (FPlatformTime::Seconds() >= EndTime)
+		{
+			break;
+		}
+	}
+	SET_DWORD_STAT(STAT_WGSCollisionDisabledCells, CollisionStreaming.GetNumDisabledCells());
+}
+
+void UWorldGridStreamSubsystem::EnforceDormantCaps()
+{
+	const UWorldGridStreamConfigs* WorldGridStreamConfigs = GetDefault<UWorldGridStreamConfigs>();
+	const int32 MaxDormantCells = WorldGridStreamConfigs->GetMaxDormantCells();
+	const int64 DormantBudgetBytes = WorldGridStreamConfigs->GetDormantMemoryBudgetMB() * 1024ll * 1024ll;
+	if (StreamingContext.GetNumCellsInState(EWorldGridStreamCellState::Dormant) == 0 || (MaxDormantCells <= 0 && DormantBudgetBytes <= 0))
+	{
+		return;
+	}
+
+	TArray<TPair<double, FInt64Vector>> DormantCells;
+	int64 DormantBytes = 0;
+	for (const TPair<FInt64Vector, FWorldGridStreamCell>& Pair : StreamingContext.GetCells())
+	{
+		if (Pair.Value.State == EWorldGridStreamCellState::Dormant)
+		{
+			DormantCells.Emplace(GetDistanceToCell(Pair.Key), Pair.Key);
+			const FWorldGridStreamCellMemory* CellMemory = MemoryGovernor.FindCellMemory(Pair.Key);
+			DormantBytes += nullptr != CellMemory ? CellMemory->GetTotalBytes() : 0;
+		}
+	}
+
+	// Farthest first
+	DormantCells.Sort([](const TPair<double, FInt64Vector>& A, const TPair<double, FInt64Vector>& B) { return A.Key > B.Key; });
+	int32 NumDormantCells = DormantCells.Num();
+	for (const TPair<double, FInt64Vector>& DormantCell : DormantCells)
+	{
+		const bool bOverCount = MaxDormantCells > 0 && NumDormantCells > MaxDormantCells;
+		const bool bOverBudget = DormantBudgetBytes > 0 && DormantBytes > DormantBudgetBytes;
+		if (false == bOverCount && false == bOverBudget)
+		{
+			break;
+		}
+
+		const FWorldGridStreamCellMemory* CellMemory = MemoryGovernor.FindCellMemory(DormantCell.Value);
+		DormantBytes -= nullptr != CellMemory ? CellMemory->GetTotalBytes() : 0;
+		--NumDormantCells;
+		UnloadCell(DormantCell.Value);
+	}
+}
+
+void UWorldGridStreamSubsystem::RequestCellsAround(const FVector& InSource, double InRadius)
+{
+	const double GridSize = WorldGridStreamSettings->VisibilityDistance;
+	const FInt64Vector MinIndex(FMath::FloorToInt64((InSource.X - InRadius) / GridSize), FMath::FloorToInt64((InSource.Y - InRadius) / GridSize), FMath::FloorToInt64((InSource.Z - InRadius) / GridSize));
+	const FInt64Vector MaxIndex(FMath::FloorToInt64((InSource.X + InRadius) / GridSize), FMath::FloorToInt64((InSource.Y + InRadius) / GridSize), FMath::FloorToInt64((InSource.Z + InRadius) / GridSize));
+
+	// Without Z distance every built layer of the column is in range
+	const int64 MinZ = WorldGridStreamSettings->bIncludeZDistance ? FMath::Max(MinIndex.Z, StreamingContext.GetMinCellZ()) : StreamingContext.GetMinCellZ();
+	const int64 MaxZ = WorldGridStreamSettings->bIncludeZDistance ? FMath::Min(MaxIndex.Z, StreamingContext.GetMaxCellZ()) : StreamingContext.GetMaxCellZ();
+	for (int64 X = MinIndex.X; X <= MaxIndex.X; ++X)
+	{
+		for (int64 Y = MinIndex.Y; Y <= MaxIndex.Y; ++Y)
+		{
+			for (int64 Z = MinZ; Z <= MaxZ; ++Z)
+			{
+				const FInt64Vector GridIndex(X, Y, Z);
+				if (StreamingContext.GetCellState(GridIndex) == EWorldGridStreamCellState::Unloaded
+					&& false == StreamingContext.FindCellPackage(GridIndex).IsNone()
+					&& GetDistanceToCell(GridIndex) <= InRadius)
+				{
+					StreamingContext.SetCellState(GridIndex, EWorldGridStreamCellState::Requested);
+				}
+			}
+		}
+	}
+}
+
+void UWorldGridStreamSubsystem::LoadCell(const FInt64Vector& InGridIndex, double InDistance)
+{
+	const FName PackageName = StreamingContext.FindCellPackage(InGridIndex);
+	if (false == StreamingContext.SetCellState(InGridIndex, EWorldGridStreamCellState::Loading))
+	{
+		return;
+	}
+
+	// Higher loads sooner, one step per ring of cells
+	const int32 Priority = FMath::Max(100 - FMath::FloorToInt32(InDistance / WorldGridStreamSettings->VisibilityDistance), 0);
+	const uint32 LoadSerial = ++CellLoadSerial;
+	StreamingContext.SetCellLoadSerial(InGridIndex, LoadSerial);
+	++InFlightCellLoads;
+	LoadPackageAsync(PackageName.ToString(), FLoadPackageAsyncDelegate::CreateUObject(this, &UWorldGridStreamSubsystem::OnCellPackageLoaded, InGridIndex, LoadSerial), Priority);
+}
+
+void UWorldGridStreamSubsystem::OnCellPackageLoaded(const FName& InPackageName, UPackage* InLoadedPackage, EAsyncLoadingResult::Type InResult, FInt64Vector InGridIndex, uint32 InLoadSerial)
+{
+	InFlightCellLoads = FMath::Max(InFlightCellLoads - 1, 0);
+
+	const FWorldGridStreamCell* Cell = StreamingContext.FindCell(InGridIndex);
+	if (nullptr == Cell || Cell->State != EWorldGridStreamCellState::Loading || Cell->LoadSerial != InLoadSerial)
+	{
+		return;
+	}
+
+	AWorldGridStreamInstancesActor* WorldGridStreamInstancesActor = StreamingContext.GetInstancesActor();
+	UWorldGridStreamInstances* WorldGridStreamInstances = nullptr;
+	if (InResult == EAsyncLoadingResult::Succeeded && nullptr != InLoadedPackage)
+	{
+		WorldGridStreamInstances = FindObject<UWorldGridStreamInstances>(InLoadedPackage, *UWorldGridStreamInstances::GetInstancesObjectName(StreamingContext.GetMapName(), InGridIndex));
+	}
+	if (nullptr == WorldGridStreamInstances || nullptr == WorldGridStreamInstancesActor)
+	{
+		UE_LOG(LogWGS, Warning, TEXT("Cell %s: Failed to load %s"), *InGridIndex.ToString(), *InPackageName.ToString());
+		StreamingContext.SetCellState(InGridIndex, EWorldGridStreamCellState::Unloaded);
+		return;
+	}
+
+	WorldGridStreamInstancesActor->WorldGridStreamInstancesMap.Add(InGridIndex, WorldGridStreamInstances);
+	StreamingContext.SetCellInstances(InGridIndex, WorldGridStreamInstances);
+	StreamingContext.SetCellState(InGridIndex, EWorldGridStreamCellState::Loaded);
+}
+
+void UWorldGridStreamSubsystem::ActivateLoadedCells()
+{
+	if (StreamingContext.GetNumCellsInState(EWorldGridStreamCellState::Loaded) > 0)
+	{
+		TArray<FInt64Vector> LoadedCells;
+		for (const TPair<FInt64Vector, FWorldGridStreamCell>& Pair : StreamingContext.GetCells())
+		{
+			if (Pair.Value.State == EWorldGridStreamCellState::Loaded)
+			{
+				LoadedCells.Add(Pair.Key);
+			}
+		}
+
+		// No collection starts until the cell is done spawning
+		const bool bCollisionStreaming = WorldGridStreamSettings->IsCollisionStreamingEnabled() && CollisionSources.Num() > 0;
+		for (const FInt64Vector& GridIndex : LoadedCells)
+		{
+			// Spawned without collision, no physics state is created until the cell enters the collision radius
+			if (true == bCollisionStreaming && GetCollisionDistanceToCell(GridIndex) > WorldGridStreamSettings->GetCollisionDistance())
+			{
+				CollisionStreaming.MarkCellDisabled(GridIndex);
+			}
+			StreamingContext.SetCellState(GridIndex, EWorldGridStreamCellState::Activating);
+			SpawnPipeline.Enqueue(GridIndex, StreamingContext.FindInstances(GridIndex));
+			GCScheduler.BeginMaterialization();
+		}
+	}
+
+	const UWorldGridStreamConfigs* WorldGridStreamConfigs = GetDefault<UWorldGridStreamConfigs>();
+	const auto GetCellDistance = [this](const FInt64Vector& GridIndex) { return GetDistanceToCell(GridIndex); };
+	const auto GetRing = [this](const FInt64Vector& GridIndex) { return GetCellRing(GridIndex); };
+	if (SpawnPipeline.GetNumCells() > 0)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_WGSSpawnActors);
+		TArray<FInt64Vector> SpawnedCells;
+		const auto OnCellActorSpawned = [this](const FInt64Vector& GridIndex, AActor* Actor)
+		{
+			StreamingContext.AddCellSpawnedActor(GridIndex, Actor);
+			if (true == CollisionStreaming.IsCellDisabled(GridIndex))
+			{
+				CollisionStreaming.DisableActor(GridIndex, Actor);
+			}
+		};
+		SpawnPipeline.Tick(GetWorld(), WorldGridStreamConfigs->GetCellSpawnBudgetSeconds(), GetCellDistance, GetRing, OnCellActorSpawned, RegistrationPasses, SpawnedCells);
+		for (int32 Index = 0; Index < SpawnedCells.Num(); ++Index)
+		{
+			GCScheduler.EndMaterialization();
+		}
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_WGSComponentRegistration);
+		const double RegistrationBudgets[] =
+		{
+			WorldGridStreamConfigs->GetRenderRegistrationBudgetSeconds(),
+			WorldGridStreamConfigs->GetCollisionRegistrationBudgetSeconds(),
+			WorldGridStreamConfigs->GetNavigationRegistrationBudgetSeconds(),
+		};
+		static_assert(UE_ARRAY_COUNT(RegistrationBudgets) == static_cast<int32>(EWorldGridStreamRegistrationPass::Num), "One budget per registration pass");
+		TArray<FInt64Vector> RegisteredCells;
+		RegistrationPasses.Tick(RegistrationBudgets, GetCellDistance, GetRing, RegisteredCells);
+		for (const FInt64Vector& GridIndex : RegisteredCells)
+		{
+			StreamingContext.SetCellState(GridIndex, EWorldGridStreamCellState::Active);
+		}
+	}
+	SET_DWORD_STAT(STAT_WGSPendingRenderRegistrations, RegistrationPasses.GetNumPending(EWorldGridStreamRegistrationPass::Render));
+	SET_DWORD_STAT(STAT_WGSPendingCollisionRegistrations, RegistrationPasses.GetNumPending(EWorldGridStreamRegistrationPass::Collision));
+	SET_DWORD_STAT(STAT_WGSPendingNavigationRegistrations, RegistrationPasses.GetNumPending(EWorldGridStreamRegistrationPass::Navigation));
+}
+
+void UWorldGridStreamSubsystem::GatherStreamingSources()
+{
+	StreamingSources.Reset();
+	const bool bListenServer = GetWorld()->IsNetMode(NM_ListenServer);
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (nullptr == PlayerController)
+		{
+			continue;
+		}
+
+		if (true == PlayerController->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			StreamingSources.Add(ViewLocation);
+		}
+		// A listen server simulates the remote pawns, the cells under them must be resident for their collision.
+		// Streamed actors are not replicated, the clients stream their own copies
+		else if (true == bListenServer)
+		{
+			if (const APawn* Pawn = PlayerController->GetPawn())
+			{
+				StreamingSources.Add(Pawn->GetActorLocation());
+			}
+		}
+	}
+}
+
+void UWorldGridStreamSubsystem::GatherTickThrottleSources()
+{
+	TickThrottleSources.Reset();
+	// Servers run the gameplay of every player, cells far from the local ones may be next to a remote one
+	const ENetMode NetMode = GetWorld()->GetNetMode();
+	if (NetMode != NM_DedicatedServer && NetMode != NM_ListenServer)
+	{
+		TickThrottleSources.Append(StreamingSources);
+		return;
+	}
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (nullptr != PlayerController)
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			TickThrottleSources.Add(ViewLocation);
+		}
+	}
+}
+
+void UWorldGridStreamSubsystem::GatherCollisionSources()
+{
+	CollisionSources.Reset();
+	if (false == WorldGridStreamSettings->IsCollisionStreamingEnabled())
+	{
+		return;
+	}
+
+	const float LookaheadSeconds = GetDefault<UWorldGridStreamConfigs>()->GetCollisionLookaheadSeconds();
+	const auto AddMover = [this, LookaheadSeconds](const AActor* Actor)
+	{
+		const FVector Location = Actor->GetActorLocation();
+		CollisionSources.Add(Location);
+		const FVector Velocity = Actor->GetVelocity();
+		if (LookaheadSeconds > 0.0f && false == Velocity.IsNearlyZero())
+		{
+			CollisionSources.Add(Location + Velocity * LookaheadSeconds);
+		}
+	};
+
+	CollisionSources.Append(StreamingSources);
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (const APawn* Pawn = nullptr != PlayerController ? PlayerController->GetPawn() : nullptr)
+		{
+			AddMover(Pawn);
+		}
+	}
+
+	CollisionGuards.RemoveAllSwap([](const TWeakObjectPtr<AActor>& Guard) { return false == Guard.IsValid(); }, EAllowShrinking::No);
+	for (const TWeakObjectPtr<AActor>& Guard : CollisionGuards)
+	{
+		AddMover(Guard.Get());
+	}
+}
+
+void UWorldGridStreamSubsystem::UpdateMemoryGovernor(float DeltaTime)
+{
+	const UWorldGridStreamConfigs* WorldGridStreamConfigs = GetDefault<UWorldGridStreamConfigs>();
+	MemoryGovernorTime += DeltaTime;
+	if (MemoryGovernorTime < WorldGridStreamConfigs->GetGovernorIntervalSeconds())
+	{
+		return;
+	}
+	SCOPE_CYCLE_COUNTER(STAT_WGSMemoryGovernor);
+	const float GovernorDeltaTime = MemoryGovernorTime;
+	MemoryGovernorTime = 0.0f;
+
+	AWorldGridStreamInstancesActor* WorldGridStreamInstancesActor = StreamingContext.GetInstancesActor();
+	if (nullptr == WorldGridStreamInstancesActor)
+	{
+		return;
+	}
+
+	TrackResidentCells();
+
+	// Measuring walks every reference of the cell's actors, only a few newly resident cells per update
+	int32 CellMeasurements = WorldGridStreamConfigs->GetCellMeasurementsPerUpdate();
+	for (const TPair<FInt64Vector, TObjectPtr<UWorldGridStreamInstances>>& Pair : WorldGridStreamInstancesActor->WorldGridStreamInstancesMap)
+	{
+		if (nullptr == Pair.Value)
+		{
+			MemoryGovernor.RemoveCell(Pair.Key);
+			continue;
+		}
+		// Loaded and Activating cells are still spawning, they are clustered and measured once all their actors exist
+		const EWorldGridStreamCellState CellState = StreamingContext.GetCellState(Pair.Key);
+		const bool bResident = CellState == EWorldGridStreamCellState::Active || CellState == EWorldGridStreamCellState::Dormant;
+		if (true == bResident && CellMeasurements > 0 && false == MemoryGovernor.IsCellTracked(Pair.Key))
+		{
+			Pair.Value->CreateCellCluster();
+			TArray<AActor*> Actors;
+			StreamingContext.GetCellActors(Pair.Key, Actors);
+			MemoryGovernor.SetCellMemory(Pair.Key, FWorldGridStreamMemoryGovernor::MeasureCell(Actors));
+			--CellMeasurements;
+		}
+	}
+
+	const bool bUnderPressure = MemoryGovernor.UpdatePressure(*WorldGridStreamConfigs, GovernorDeltaTime);
+	SET_DWORD_STAT(STAT_WGSTrackedCells, MemoryGovernor.GetNumTrackedCells());
+	SET_FLOAT_STAT(STAT_WGSTrackedCellMB, MemoryGovernor.GetTrackedBytes() / (1024.0 * 1024.0));
+	SET_FLOAT_STAT(STAT_WGSRadiusScale, MemoryGovernor.GetRadiusScale());
+	SET_DWORD_STAT(STAT_WGSMemoryEvictions, MemoryGovernor.GetEvictionCount());
+
+	// Without a streaming source there is no notion of far
+	if (false == bUnderPressure || StreamingSources.Num() == 0)
+	{
+		return;
+	}
+
+	// The cells around the sources are never evicted
+	TArray<FInt64Vector> Evictions;
+	MemoryGovernor.GatherEvictions([this](const FInt64Vector& GridIndex) { return GetDistanceToCell(GridIndex); },
+		WorldGridStreamSettings->VisibilityDistance, MemoryGovernor.GetBytesOverBudget(*WorldGridStreamConfigs), WorldGridStreamConfigs->GetMaxEvictionsPerUpdate(), Evictions);
+	for (const FInt64Vector& GridIndex : Evictions)
+	{
+		if (true == UnloadCell(GridIndex))
+		{
+			MemoryGovernor.RecordEviction();
+			UE_LOG(LogWGS, Verbose, TEXT("Memory pressure: Evicted cell %s at %.0f uu, radius scale %.2f"), *GridIndex.ToString(), GetDistanceToCell(GridIndex), MemoryGovernor.GetRadiusScale());
+		}
+	}
+}
+
+void UWorldGridStreamSubsystem::TrackResidentCells()
+{
+	AWorldGridStreamInstancesActor* WorldGridStreamInstancesActor = StreamingContext.GetInstancesActor();
+	if (nullptr == WorldGridStreamInstancesActor)
+	{
+		return;
+	}
+
+	for (const TPair<FInt64Vector, TObjectPtr<UWorldGridStreamInstances>>& Pair : WorldGridStreamInstancesActor->WorldGridStreamInstancesMap)
+	{
+		if (nullptr != Pair.Value && StreamingContext.GetCellState(Pair.Key) == EWorldGridStreamCellState::Unloaded)
+		{
+			StreamingContext.AddActiveCell(Pair.Key, Pair.Value);
+		}
+	}
+}
+
+void UWorldGridStreamSubsystem::MapPlacedActors(UWorld& InWorld)
+{
+	const int32 GridSize = FMath::FloorToInt32(WorldGridStreamSettings->VisibilityDistance);
+	if (GridSize <= 0)
+	{
+		return;
+	}
+
+	int32 NumPlacedActors = 0;
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		AActor* Actor = *It;
+		// Players and their controllers move between cells, attached actors follow their parent and infos have no location
+		if (nullptr == Actor->GetRootComponent() || nullptr != Actor->GetAttachParentActor())
+		{
+			continue;
+		}
+		if (true == Actor->IsA<AInfo>() || true == Actor->IsA<AController>() || true == Actor->IsA<APawn>() || true == Actor->IsA<AWorldGridStreamInstancesActor>())
+		{
+			continue;
+		}
+		const FInt64Vector GridIndex = FWorldGridStreamMathHelpers::GetGridIndex(Actor->GetActorLocation(), GridSize, false);
+		StreamingContext.AddCellPlacedActor(GridIndex, Actor);
+		++NumPlacedActors;
+	}
+	UE_LOG(LogWGS, Log, TEXT("Mapped %d placed actors to %d cells"), NumPlacedActors, StreamingContext.GetCells().Num());
+}
+
 #if WITH_EDITOR
 void UWorldGridStreamSubsystem::OnMapChanged(UWorld* InWorld, EMapChangeType ChangeType)
 {
@@ -0,0 +1,171 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "WorldGridStreamTickThrottle.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+
+#include "WorldGridStreamPrivate.h"
+
+BEGIN_FUNCTION_BUILD_OPTIMIZATION
+
+void FWorldGridStreamTickThrottle::SetCellRing(const FInt64Vector& InGridIndex, const TArray<AActor*>& InActors, int32 InRing, int32 InStaggerFrames)
+{
+	FThrottledCell* Cell = Cells.Find(InGridIndex);
+	if (nullptr == Cell)
+	{
+		Cell = &Cells.Add(InGridIndex);
+
+		for (AActor* Actor : InActors)
+		{
+			// Templates loaded with the cell package are not in a world and never tick
+			if (false == ::IsValid(Actor) || nullptr == Actor->GetWorld())
+			{
+				continue;
+			}
+			if (true == Actor->PrimaryActorTick.bCanEverTick)
+			{
+				Cell->Objects.Add({ Actor, Actor->GetActorTickInterval() });
+			}
+			Actor->ForEachComponent(false, [Cell](UActorComponent* Component)
+			{
+				if (true == Component->PrimaryComponentTick.bCanEverTick)
+				{
+					Cell->Objects.Add({ Component, Component->GetComponentTickInterval() });
+				}
+			});
+		}
+	}
+
+	if (Cell->Ring == InRing)
+	{
+		return;
+	}
+	Cell->Ring = InRing;
+
+	// Each object is updated on its own frame, UpdateTickIntervalAndCoolDown starts its interval from there
+	const uint64 FrameCounter = GFrameCounter;
+	for (int32 ObjectIndex = 0; ObjectIndex < Cell->Objects.Num(); ++ObjectIndex)
+	{
+		PendingUpdates.Add({ InGridIndex, ObjectIndex, FrameCounter + static_cast<uint64>(ObjectIndex % FMath::Max(InStaggerFrames, 1)) });
+	}
+}
+
+void FWorldGridStreamTickThrottle::RestoreCell(const FInt64Vector& InGridIndex)
+{
+	FThrottledCell Cell;
+	if (false == Cells.RemoveAndCopyValue(InGridIndex, Cell))
+	{
+		return;
+	}
+
+	for (FThrottledObject& ThrottledObject : Cell.Objects)
+	{
+		if (AActor* Actor = Cast<AActor>(ThrottledObject.Object.Get()))
+		{
+			Actor->SetActorTickInterval(ThrottledObject.OriginalTickInterval);
+			if (true == ThrottledObject.bSuspended)
+			{
+				Actor->SetActorTickEnabled(true);
+			}
+		}
+		else if (UActorComponent* Component = Cast<UActorComponent>(ThrottledObject.Object.Get()))
+		{
+			Component->SetComponentTickInterval(ThrottledObject.OriginalTickInterval);
+			if (true == ThrottledObject.bSuspended)
+			{
+				Component->SetComponentTickEnabled(true);
+			}
+		}
+	}
+	PendingUpdates.RemoveAll([&InGridIndex](const FPendingUpdate& PendingUpdate) { return PendingUpdate.GridIndex == InGridIndex; });
+}
+
+int32 FWorldGridStreamTickThrottle::GetCellRing(const FInt64Vector& InGridIndex) const
+{
+	const FThrottledCell* Cell = Cells.Find(InGridIndex);
+	return nullptr != Cell ? Cell->Ring : INDEX_NONE;
+}
+
+int32 FWorldGridStreamTickThrottle::GetNumSuspended() const
+{
+	int32 NumSuspended = 0;
+	for (const TPair<FInt64Vector, FThrottledCell>& Pair : Cells)
+	{
+		for (const FThrottledObject& ThrottledObject : Pair.Value.Objects)
+		{
+			NumSuspended += ThrottledObject.bSuspended ? 1 : 0;
+		}
+	}
+	return NumSuspended;
+}
+
+void FWorldGridStreamTickThrottle::Tick(const TArray<float>& InRingTickIntervals)
+{
+	const uint64 FrameCounter = GFrameCounter;
+	for (int32 Index = PendingUpdates.Num() - 1; Index >= 0; --Index)
+	{
+		const FPendingUpdate& PendingUpdate = PendingUpdates[Index];
+		if (PendingUpdate.DueFrame > FrameCounter)
+		{
+			continue;
+		}
+
+		FThrottledCell* Cell = Cells.Find(PendingUpdate.GridIndex);
+		if (nullptr != Cell && Cell->Objects.IsValidIndex(PendingUpdate.ObjectIndex))
+		{
+			ApplyRing(Cell->Objects[PendingUpdate.ObjectIndex], Cell->Ring, InRingTickIntervals);
+		}
+		PendingUpdates.RemoveAtSwap(Index, EAllowShrinking::No);
+	}
+}
+
+void FWorldGridStreamTickThrottle::ApplyRing(FThrottledObject& InThrottledObject, int32 InRing, const TArray<float>& InRingTickIntervals)
+{
+	const bool bSuspend = false == InRingTickIntervals.IsValidIndex(InRing) || InRingTickIntervals[InRing] < 0.0f;
+	const float TickInterval = bSuspend ? InThrottledObject.OriginalTickInterval : FMath::Max(InThrottledObject.OriginalTickInterval, InRingTickIntervals[InRing]);
+
+	if (AActor* Actor = Cast<AActor>(InThrottledObject.Object.Get()))
+	{
+		if (true == bSuspend)
+		{
+			if (true == Actor->IsActorTickEnabled())
+			{
+				Actor->SetActorTickEnabled(false);
+				InThrottledObject.bSuspended = true;
+			}
+			return;
+		}
+		if (true == InThrottledObject.bSuspended)
+		{
+			Actor->SetActorTickEnabled(true);
+			InThrottledObject.bSuspended = false;
+		}
+		Actor->SetActorTickInterval(TickInterval);
+	}
+	else if (UActorComponent* Component = Cast<UActorComponent>(InThrottledObject.Object.Get()))
+	{
+		if (true == bSuspend)
+		{
+			if (true == Component->IsComponentTickEnabled())
+			{
+				Component->SetComponentTickEnabled(false);
+				InThrottledObject.bSuspended = true;
+			}
+			return;
+		}
+		if (true == InThrottledObject.bSuspended)
+		{
+			Component->SetComponentTickEnabled(true);
+			InThrottledObject.bSuspended = false;
+		}
+		Component->SetComponentTickInterval(TickInterval);
+	}
+}
+
+void FWorldGridStreamTickThrottle::Reset()
+{
+	Cells.Empty();
+	PendingUpdates.Empty();
+}
+
+END_FUNCTION_BUILD_OPTIMIZATION
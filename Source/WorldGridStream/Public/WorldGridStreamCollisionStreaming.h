@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+/* * Collision streaming of UWorldGridStreamSubsystem.
+ * Resident cells outside the collision radius keep their actors with actor collision disabled and no physics state.
+ * Disabling is immediate, enabling creates the physics state again and is done nearest cell first under a budget.
+ */
+class FWorldGridStreamCollisionStreaming
+{
+	//Variable declarations
+public:
+protected:
+private:
+	// Actors whose collision was switched off, per cell without collision
+	TMap<FInt64Vector, TArray<TWeakObjectPtr<AActor>>> DisabledCells;
+
+	//Function declarations
+public:
+	bool IsCellDisabled(const FInt64Vector& InGridIndex) const { return DisabledCells.Contains(InGridIndex); }
+	int32 GetNumDisabledCells() const { return DisabledCells.Num(); }
+
+	/* * A cell about to spawn outside the collision radius, its actors are passed to DisableActor as they spawn */
+	void MarkCellDisabled(const FInt64Vector& InGridIndex) { DisabledCells.FindOrAdd(InGridIndex); }
+	void DisableActor(const FInt64Vector& InGridIndex, AActor* InActor);
+
+	/* * Switches off the collision of the cell's actors that are in a world and destroys their physics state */
+	void DisableCell(const FInt64Vector& InGridIndex, const TArray<AActor*>& InActors);
+	void EnableCell(const FInt64Vector& InGridIndex);
+	/* * The cell is unloaded, its actors are destroyed as they are */
+	void Remove(const FInt64Vector& InGridIndex) { DisabledCells.Remove(InGridIndex); }
+
+	void Reset() { DisabledCells.Empty(); }
+
+protected:
+private:
+};
@@ -21,11 +21,149 @@ protected:
 	UPROPERTY(config, EditAnywhere, Category = "World Grid Stream", meta=(DisplayName="Streaming White List Classes"))
 	TArray<TObjectPtr<UClass>> StreamingWhiteListClasses; //Streaming  Class ϴ 迭. White List ִ Class Black List ִ Class ϰ Streaming Ѵ.
 #endif // WITH_EDITORONLY_DATA
+
+	/* * Runtime memory governor budgets. Override per platform in Config/<Platform>/<Platform>WorldGridStreamConfigs.ini
+	 * Estimated bytes of all resident cells, the farthest cells are evicted above it. 0 is unlimited.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Memory", meta=(DisplayName="Cell Memory Budget (MB)", ClampMin=0))
+	int32 CellMemoryBudgetMB;
+
+	/* * Platform memory pressure starts below this much free physical memory. */
+	UPROPERTY(config, EditAnywhere, Category = "Memory", meta=(DisplayName="Min Free Physical (MB)", ClampMin=0))
+	int32 MinFreePhysicalMB;
+
+	/* * Platform memory pressure starts above max(MaxUsedPhysicalMB, TotalPhysical * MaxUsedPhysicalRatio) used physical memory. */
+	UPROPERTY(config, EditAnywhere, Category = "Memory", meta=(DisplayName="Max Used Physical (MB)", ClampMin=0))
+	int32 MaxUsedPhysicalMB;
+
+	UPROPERTY(config, EditAnywhere, Category = "Memory", meta=(DisplayName="Max Used Physical Ratio", ClampMin=0.0, ClampMax=1.0))
+	float MaxUsedPhysicalRatio;
+
+	/* * The streaming radius shrinks by RadiusShrinkStep per governor update under pressure, down to MinRadiusScale,
+	 * and grows back by the same step every PressureRecoverySeconds without pressure.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Memory", meta=(ClampMin=0.0, ClampMax=1.0))
+	float MinRadiusScale;
+
+	UPROPERTY(config, EditAnywhere, Category = "Memory", meta=(ClampMin=0.0, ClampMax=1.0))
+	float RadiusShrinkStep;
+
+	UPROPERTY(config, EditAnywhere, Category = "Memory", meta=(ClampMin=0.0))
+	float PressureRecoverySeconds;
+
+	UPROPERTY(config, EditAnywhere, Category = "Memory", meta=(ClampMin=0.0))
+	float GovernorIntervalSeconds;
+
+	/* * Cells evicted per governor update, cells are destroyed on the game thread. */
+	UPROPERTY(config, EditAnywhere, Category = "Memory", meta=(ClampMin=1))
+	int32 MaxEvictionsPerUpdate;
+
+	/* * Cells measured per governor update once they are resident. */
+	UPROPERTY(config, EditAnywhere, Category = "Memory", meta=(ClampMin=1))
+	int32 CellMeasurementsPerUpdate;
+
+	/* * Cell packages loading at the same time, the nearest requested cells are issued first. */
+	UPROPERTY(config, EditAnywhere, Category = "Streaming", meta=(ClampMin=1))
+	int32 MaxConcurrentCellLoads;
+
+	/* * Cells are requested within the streaming radius and cancelled or unloaded beyond the radius scaled by this. */
+	UPROPERTY(config, EditAnywhere, Category = "Streaming", meta=(ClampMin=1.0))
+	float CellUnloadDistanceScale;
+
+	/* * Game thread time per frame spent spawning and finishing the actors of streamed cells, at least one actor per frame. */
+	UPROPERTY(config, EditAnywhere, Category = "Streaming", meta=(DisplayName="Cell Spawn Budget (ms)", ClampMin=0.1))
+	float CellSpawnBudgetMS;
+
+	/* * Game thread time per frame spent destroying the actors of unloaded cells, at least one actor per frame. */
+	UPROPERTY(config, EditAnywhere, Category = "Streaming", meta=(DisplayName="Cell Unload Budget (ms)", ClampMin=0.1))
+	float CellUnloadBudgetMS;
+
+	/* * Game thread time per frame of each component registration pass of activating cells, at least one component per pass and frame. */
+	UPROPERTY(config, EditAnywhere, Category = "Streaming", meta=(DisplayName="Render Registration Budget (ms)", ClampMin=0.1))
+	float RenderRegistrationBudgetMS;
+
+	UPROPERTY(config, EditAnywhere, Category = "Streaming", meta=(DisplayName="Collision Registration Budget (ms)", ClampMin=0.1))
+	float CollisionRegistrationBudgetMS;
+
+	UPROPERTY(config, EditAnywhere, Category = "Streaming", meta=(DisplayName="Navigation Registration Budget (ms)", ClampMin=0.1))
+	float NavigationRegistrationBudgetMS;
+
+	/* * Caps of the dormant tier, the farthest dormant cells are unloaded above them. 0 is unlimited. */
+	UPROPERTY(config, EditAnywhere, Category = "Streaming", meta=(ClampMin=0))
+	int32 MaxDormantCells;
+
+	UPROPERTY(config, EditAnywhere, Category = "Streaming", meta=(DisplayName="Dormant Memory Budget (MB)", ClampMin=0))
+	int32 DormantMemoryBudgetMB;
+
+	/* * Tick interval of the actors of active cells per ring, the distance in cells to the nearest streaming source.
+	 * 0 ticks every frame, rings past the end of the list or with a negative interval do not tick. Never lowers an actor's own interval.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "Tick Throttling")
+	bool bThrottleTicks;
+
+	UPROPERTY(config, EditAnywhere, Category = "Tick Throttling", meta=(EditCondition="bThrottleTicks"))
+	TArray<float> RingTickIntervals;
+
+	/* * A ring change is spread over this many frames so the cell's ticks do not line up. */
+	UPROPERTY(config, EditAnywhere, Category = "Tick Throttling", meta=(EditCondition="bThrottleTicks", ClampMin=1))
+	int32 TickStaggerFrames;
+
+	/* * Pawns and collision guards also stream collision where their velocity takes them within this time. */
+	UPROPERTY(config, EditAnywhere, Category = "Collision Streaming", meta=(ClampMin=0.0))
+	float CollisionLookaheadSeconds;
+
+	/* * Game thread time per frame spent creating the physics state of cells entering the collision radius, at least one cell per frame. */
+	UPROPERTY(config, EditAnywhere, Category = "Collision Streaming", meta=(DisplayName="Collision Enable Budget (ms)", ClampMin=0.1))
+	float CollisionEnableBudgetMS;
+
+	/* * Objects destroyed by cell unloads before a collection is started. */
+	UPROPERTY(config, EditAnywhere, Category = "Garbage Collection", meta=(ClampMin=1))
+	int32 GCDebtThreshold;
+
+	/* * A smaller debt is still collected after waiting this long, even while cells are being materialized. */
+	UPROPERTY(config, EditAnywhere, Category = "Garbage Collection", meta=(ClampMin=0.0))
+	float GCMaxDebtSeconds;
+
+	/* * Reachability and purge time per frame while a scheduled collection is pending. */
+	UPROPERTY(config, EditAnywhere, Category = "Garbage Collection", meta=(DisplayName="GC Time Budget (ms)", ClampMin=0.1))
+	float GCTimeBudgetMS;
+
+	/* * Resident cells form one GC cluster each in cooked games, also requires gc.CreateGCClusters. */
+	UPROPERTY(config, EditAnywhere, Category = "Garbage Collection")
+	bool bCreateCellClusters;
 private:
 
 public:
 	UWorldGridStreamConfigs()
 		: Super()
+		, CellMemoryBudgetMB(0)
+		, MinFreePhysicalMB(1024)
+		, MaxUsedPhysicalMB(32 * 1024)
+		, MaxUsedPhysicalRatio(0.5f)
+		, MinRadiusScale(0.5f)
+		, RadiusShrinkStep(0.1f)
+		, PressureRecoverySeconds(5.0f)
+		, GovernorIntervalSeconds(0.5f)
+		, MaxEvictionsPerUpdate(2)
+		, CellMeasurementsPerUpdate(4)
+		, MaxConcurrentCellLoads(4)
+		, CellUnloadDistanceScale(1.25f)
+		, CellSpawnBudgetMS(2.0f)
+		, CellUnloadBudgetMS(1.0f)
+		, RenderRegistrationBudgetMS(1.0f)
+		, CollisionRegistrationBudgetMS(1.0f)
+		, NavigationRegistrationBudgetMS(0.5f)
+		, MaxDormantCells(0)
+		, DormantMemoryBudgetMB(256)
+		, bThrottleTicks(true)
+		, RingTickIntervals({ 0.0f, 0.0f, 0.1f, 0.25f, 0.5f })
+		, TickStaggerFrames(4)
+		, CollisionLookaheadSeconds(1.0f)
+		, CollisionEnableBudgetMS(1.0f)
+		, GCDebtThreshold(2048)
+		, GCMaxDebtSeconds(30.0f)
+		, GCTimeBudgetMS(2.0f)
+		, bCreateCellClusters(true)
 	{
 #if WITH_EDITORONLY_DATA
 		StreamingBlackListClasses.Emplace(AWorldGridStreamSettings::StaticClass());
@@ -35,6 +173,36 @@ public:
 	const TArray<TObjectPtr<UClass>>& GetStreamingBlackListClasses() const { return StreamingBlackListClasses; }
 	const TArray<TObjectPtr<UClass>>& GetStreamingWhiteListClasses() const { return StreamingWhiteListClasses; }
 #endif // WITH_EDITOR
+	int64 GetCellMemoryBudgetMB() const { return CellMemoryBudgetMB; }
+	uint64 GetMinFreePhysicalBytes() const { return static_cast<uint64>(FMath::Max(MinFreePhysicalMB, 0)) * 1024 * 1024; }
+	uint64 GetMaxUsedPhysicalBytes(uint64 TotalPhysical) const
+	{
+		return FMath::Max(static_cast<uint64>(FMath::Max(MaxUsedPhysicalMB, 0)) * 1024 * 1024, static_cast<uint64>(TotalPhysical * FMath::Clamp(MaxUsedPhysicalRatio, 0.0f, 1.0f)));
+	}
+	float GetMinRadiusScale() const { return FMath::Clamp(MinRadiusScale, 0.0f, 1.0f); }
+	float GetRadiusShrinkStep() const { return FMath::Clamp(RadiusShrinkStep, 0.0f, 1.0f); }
+	float GetPressureRecoverySeconds() const { return PressureRecoverySeconds; }
+	float GetGovernorIntervalSeconds() const { return GovernorIntervalSeconds; }
+	int32 GetMaxEvictionsPerUpdate() const { return FMath::Max(MaxEvictionsPerUpdate, 1); }
+	int32 GetCellMeasurementsPerUpdate() const { return FMath::Max(CellMeasurementsPerUpdate, 1); }
+	int32 GetMaxConcurrentCellLoads() const { return FMath::Max(MaxConcurrentCellLoads, 1); }
+	float GetCellUnloadDistanceScale() const { return FMath::Max(CellUnloadDistanceScale, 1.0f); }
+	double GetCellSpawnBudgetSeconds() const { return FMath::Max(CellSpawnBudgetMS, 0.1f) / 1000.0; }
+	double GetCellUnloadBudgetSeconds() const { return FMath::Max(CellUnloadBudgetMS, 0.1f) / 1000.0; }
+	double GetRenderRegistrationBudgetSeconds() const { return FMath::Max(RenderRegistrationBudgetMS, 0.1f) / 1000.0; }
+	double GetCollisionRegistrationBudgetSeconds() const { return FMath::Max(CollisionRegistrationBudgetMS, 0.1f) / 1000.0; }
+	double GetNavigationRegistrationBudgetSeconds() const { return FMath::Max(NavigationRegistrationBudgetMS, 0.1f) / 1000.0; }
+	int32 GetMaxDormantCells() const { return MaxDormantCells; }
+	int64 GetDormantMemoryBudgetMB() const { return DormantMemoryBudgetMB; }
+	bool ShouldThrottleTicks() const { return bThrottleTicks; }
+	const TArray<float>& GetRingTickIntervals() const { return RingTickIntervals; }
+	int32 GetTickStaggerFrames() const { return FMath::Max(TickStaggerFrames, 1); }
+	float GetCollisionLookaheadSeconds() const { return FMath::Max(CollisionLookaheadSeconds, 0.0f); }
+	double GetCollisionEnableBudgetSeconds() const { return FMath::Max(CollisionEnableBudgetMS, 0.1f) / 1000.0; }
+	int32 GetGCDebtThreshold() const { return FMath::Max(GCDebtThreshold, 1); }
+	float GetGCMaxDebtSeconds() const { return GCMaxDebtSeconds; }
+	double GetGCTimeBudgetSeconds() const { return FMath::Max(GCTimeBudgetMS, 0.1f) / 1000.0; }
+	bool IsCellClusteringEnabled() const { return bCreateCellClusters; }
 protected:
 private:
 };
\ No newline at end of file
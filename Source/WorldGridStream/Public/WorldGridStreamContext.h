@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+class AActor;
+class AWorldGridStreamInstancesActor;
+class UWorldGridStreamInstances;
+
+/* * Lifecycle of one grid cell at runtime.
+ * Unloaded -> Requested -> Loading -> Loaded -> Activating -> Active -> Deactivating -> Unloaded
+ * Active <-> Dormant between the streaming radius and the dormant radius, Dormant -> Deactivating when unloaded from there.
+ * Requested, Loading and Loaded may go back to Unloaded when the cell is cancelled before it is activated.
+ */
+enum class EWorldGridStreamCellState : uint8
+{
+	Unloaded,
+	Requested,
+	Loading,
+	Loaded,
+	Activating,
+	Active,
+	Dormant,
+	Deactivating,
+	Num
+};
+
+WORLDGRIDSTREAM_API const TCHAR* LexToString(EWorldGridStreamCellState InState);
+
+struct FWorldGridStreamCell
+{
+	FInt64Vector GridIndex = FInt64Vector::ZeroValue;
+	EWorldGridStreamCellState State = EWorldGridStreamCellState::Unloaded;
+	double StateStartTime = 0.0;
+	TWeakObjectPtr<UWorldGridStreamInstances> Instances;
+	// Identifies the package load of the current Loading state, a completed load of a cancelled request does not match
+	uint32 LoadSerial = 0;
+	// Actors spawned from the cell's WorldGridStreamActors. Not referenced from the instances, their cluster is fixed once created
+	TArray<TWeakObjectPtr<AActor>> SpawnedActors;
+	// Actors saved in the map within the cell, mapped on dedicated servers where cells are not streamed
+	TArray<TWeakObjectPtr<AActor>> PlacedActors;
+};
+
+/* * Time cells spent in one state, accumulated when they leave it */
+struct FWorldGridStreamCellStateTiming
+{
+	int32 ExitCount = 0;
+	double TotalSeconds = 0.0;
+	double MaxSeconds = 0.0;
+
+	double GetAverageSeconds() const { return ExitCount > 0 ? TotalSeconds / ExitCount : 0.0; }
+};
+
+/* * Per-world streaming context of UWorldGridStreamSubsystem.
+ * Caches the world's AWorldGridStreamInstancesActor and tracks every non-Unloaded cell, state lookups and counters are O(1).
+ * Unloaded cells are not stored.
+ */
+class FWorldGridStreamContext
+{
+	//Variable declarations
+public:
+protected:
+private:
+	TWeakObjectPtr<UWorld> World;
+	TWeakObjectPtr<AWorldGridStreamInstancesActor> InstancesActor;
+
+	TMap<FInt64Vector, FWorldGridStreamCell> Cells;
+
+	// Every cell package built for the world's map
+	FString MapName;
+	TMap<FInt64Vector, FName> CellPackages;
+	int64 MinCellZ = 0;
+	int64 MaxCellZ = -1;
+	int32 StateCounts[static_cast<int32>(EWorldGridStreamCellState::Num)] = {};
+	FWorldGridStreamCellStateTiming StateTimings[static_cast<int32>(EWorldGridStreamCellState::Num)];
+
+	//Function declarations
+public:
+	void Initialize(UWorld* InWorld);
+	void Reset();
+
+	/* * Indexes the world's cell packages from the asset registry */
+	void GatherCellPackages();
+	const FString& GetMapName() const { return MapName; }
+	FName FindCellPackage(const FInt64Vector& InGridIndex) const { return CellPackages.FindRef(InGridIndex); }
+	int32 GetNumCellPackages() const { return CellPackages.Num(); }
+	int64 GetMinCellZ() const { return MinCellZ; }
+	int64 GetMaxCellZ() const { return MaxCellZ; }
+
+	/* * The linear PerModuleDataObjects lookup only runs when the cached actor is gone */
+	WORLDGRIDSTREAM_API AWorldGridStreamInstancesActor* GetInstancesActor();
+	WORLDGRIDSTREAM_API UWorldGridStreamInstances* FindInstances(const FInt64Vector& InGridIndex);
+
+	const FWorldGridStreamCell* FindCell(const FInt64Vector& InGridIndex) const { return Cells.Find(InGridIndex); }
+	WORLDGRIDSTREAM_API EWorldGridStreamCellState GetCellState(const FInt64Vector& InGridIndex) const;
+	const TMap<FInt64Vector, FWorldGridStreamCell>& GetCells() const { return Cells; }
+
+	static WORLDGRIDSTREAM_API bool IsValidTransition(EWorldGridStreamCellState From, EWorldGridStreamCellState To);
+	/* * Returns false and leaves the cell as is when the transition is not valid. Unloaded removes the cell */
+	WORLDGRIDSTREAM_API bool SetCellState(const FInt64Vector& InGridIndex, EWorldGridStreamCellState InState);
+	/* * Cells already resident when the context starts tracking them, e.g. saved in the map */
+	void AddActiveCell(const FInt64Vector& InGridIndex, UWorldGridStreamInstances* InInstances);
+	void SetCellInstances(const FInt64Vector& InGridIndex, UWorldGridStreamInstances* InInstances);
+	void SetCellLoadSerial(const FInt64Vector& InGridIndex, uint32 InLoadSerial);
+	void AddCellSpawnedActor(const FInt64Vector& InGridIndex, AActor* InActor);
+	/* * Maps an actor saved in the map to its cell, tracked as Active without instances */
+	void AddCellPlacedActor(const FInt64Vector& InGridIndex, AActor* InActor);
+	/* * Spawned actors still alive, gameplay may have destroyed some */
+	void GetCellSpawnedActors(const FInt64Vector& InGridIndex, TArray<AActor*>& OutActors) const;
+	/* * Spawned and placed actors still alive and the instances' WorldGridStreamActors, templates that are not in a world included */
+	void GetCellActors(const FInt64Vector& InGridIndex, TArray<AActor*>& OutActors) const;
+
+	int32 GetNumCellsInState(EWorldGridStreamCellState InState) const { return StateCounts[static_cast<int32>(InState)]; }
+	const FWorldGridStreamCellStateTiming& GetStateTiming(EWorldGridStreamCellState InState) const { return StateTimings[static_cast<int32>(InState)]; }
+	double GetSecondsInState(const FInt64Vector& InGridIndex) const;
+
+	void DumpStates(FOutputDevice& Ar) const;
+
+protected:
+private:
+	void LeaveState(FWorldGridStreamCell& Cell, double Now);
+};
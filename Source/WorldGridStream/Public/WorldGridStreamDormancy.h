@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UActorComponent;
+class AActor;
+
+/* * Dormant tier of UWorldGridStreamSubsystem.
+ * A dormant cell keeps its spawned actors resident but hidden, without collision and without tick,
+ * its primitive components are also unregistered when AWorldGridStreamSettings::bUnregisterDormantComponents is set.
+ * Only what was switched off is switched back on, waking a cell spawns and loads nothing.
+ */
+class FWorldGridStreamDormancy
+{
+	//Variable declarations
+public:
+protected:
+private:
+	struct FDormantActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		bool bWasHidden = false;
+		bool bHadCollision = false;
+	};
+	struct FDormantCell
+	{
+		TArray<FDormantActor> Actors;
+		// Actors and components whose tick was enabled
+		TArray<TWeakObjectPtr<UObject>> TickDisabledObjects;
+		TArray<TWeakObjectPtr<UActorComponent>> UnregisteredComponents;
+	};
+	TMap<FInt64Vector, FDormantCell> DormantCells;
+
+	//Function declarations
+public:
+	/* * Hides the cell's actors that are in a world, switches off their collision and ticks */
+	void MakeDormant(const FInt64Vector& InGridIndex, const TArray<AActor*>& InActors, bool bInUnregisterComponents);
+	void MakeActive(const FInt64Vector& InGridIndex);
+	/* * The cell is unloaded, its actors are destroyed as they are */
+	void Remove(const FInt64Vector& InGridIndex) { DormantCells.Remove(InGridIndex); }
+	bool IsDormant(const FInt64Vector& InGridIndex) const { return DormantCells.Contains(InGridIndex); }
+	int32 GetNumDormantCells() const { return DormantCells.Num(); }
+
+	void Reset() { DormantCells.Empty(); }
+
+protected:
+private:
+};
@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorldGridStreamConfigs;
+
+/* * Runtime garbage collection scheduler of UWorldGridStreamSubsystem.
+ * Unloaded cells add their destroyed objects as debt. Once the debt passes GCDebtThreshold, or has waited GCMaxDebtSeconds,
+ * a collection is started and its reachability and purge are stepped within GCTimeBudgetMS per frame.
+ * A collection waits for a frame without cells being materialized, unless the debt has waited GCMaxDebtSeconds.
+ */
+class FWorldGridStreamGCScheduler
+{
+	//Variable declarations
+public:
+protected:
+private:
+	int32 UnloadedObjectDebt = 0;
+	float DebtSeconds = 0.0f;
+	int32 MaterializingCells = 0;
+	bool bCollecting = false;
+	int32 CollectionCount = 0;
+
+	//Function declarations
+public:
+	WORLDGRIDSTREAM_API void AddDebt(int32 NumObjects);
+	int32 GetDebt() const { return UnloadedObjectDebt; }
+
+	void BeginMaterialization() { ++MaterializingCells; }
+	void EndMaterialization() { MaterializingCells = FMath::Max(MaterializingCells - 1, 0); }
+	bool IsMaterializing() const { return MaterializingCells > 0; }
+
+	/* * Steps a pending collection within the frame budget, or starts one when the debt is due */
+	WORLDGRIDSTREAM_API void Tick(const UWorldGridStreamConfigs& Configs, float DeltaTime);
+	bool IsCollecting() const { return bCollecting; }
+	int32 GetCollectionCount() const { return CollectionCount; }
+
+	void Reset();
+
+protected:
+private:
+};
@@ -16,8 +16,12 @@ private:
 public:
 	static WORLDGRIDSTREAM_API bool HasExceededMaxMemory();
 	static WORLDGRIDSTREAM_API bool ShouldCollectGarbage();
+	/* * Full blocking collection for the builder, the runtime streamer goes through FWorldGridStreamGCScheduler */
 	static WORLDGRIDSTREAM_API void DoCollectGarbage();
 
+	/* * LLM tag allocations of cells in a distance ring are attributed to, see WGS_LLM_SCOPE_RING. Rings past the last share its tag */
+	static WORLDGRIDSTREAM_API FName GetRingLLMTagName(int32 InRing);
+
 	// Simulate an engine frame tick
 	static WORLDGRIDSTREAM_API void FakeEngineTick(UWorld* World);
 
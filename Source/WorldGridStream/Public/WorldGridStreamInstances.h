@@ -34,8 +34,24 @@ private:
 public:
 	UWorldGridStreamInstances();
 	virtual ~UWorldGridStreamInstances();
+
+	// Begin UObject overrides
+	virtual bool CanBeClusterRoot() const override;
+	// End UObject overrides
+
+	/* * Clusters a resident cell that was not clustered by the package loader */
+	void CreateCellCluster();
+	/* * Before the cell's actors are destroyed, its objects are collected one by one afterwards */
+	void DissolveCellCluster();
 	
 
+	/* * Key of ActorClassMaps */
+	static uint64 GetActorClassKey(const FString& InActorName);
+
+	/* * <Map>_<GridIndex>, in /Game/WorldGridStream/<Map>_<GridIndex> */
+	static FString GetInstancesObjectName(const FString& InMapName, const FInt64Vector& InGridIndex);
+	static FString GetInstancesPackageName(const FString& InMapName, const FInt64Vector& InGridIndex);
+
 	static UWorldGridStreamInstances* FindInstances(UWorld* InWorld, const FInt64Vector& GridIndex);
 	static UWorldGridStreamInstances* FindOrCreateInstances(UWorld* InWorld, const FInt64Vector& GridIndex);
 protected:
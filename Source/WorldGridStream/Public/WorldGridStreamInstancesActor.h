@@ -12,9 +12,14 @@ class AWorldGridStreamInstancesActor : public AActor
 	GENERATED_BODY()
 
 	friend class UWorldGridStreamInstances;
+	friend class UWorldGridStreamSubsystem;
+	friend class FWorldGridStreamContext;
 // Variables
 public:
 protected:
+	/* * Resident cells only, unloaded cells are removed so they add nothing to the GC reference walk.
+	 * In cooked games every cell is a GC cluster root, referencing it marks the whole cell.
+	 */
 	UPROPERTY(Transient, VisibleAnywhere, Category = "World Grid Stream Instances")
 	TMap<FInt64Vector, TObjectPtr<class UWorldGridStreamInstances>> WorldGridStreamInstancesMap;
 
@@ -29,8 +34,7 @@ public:
 	void BeginDestroy() override;
 	void Serialize(FArchive& Ar) override;
 
-	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
-	
+	/* * Linear PerModuleDataObjects lookup, at runtime use FWorldGridStreamContext::GetInstancesActor */
 	static AWorldGridStreamInstancesActor* GetWorldGridStreamInstancesActor(const UWorld* World);
 
 	void SetWorld(UWorld* InWorld)
@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UWorldGridStreamConfigs;
+
+/* * Estimated memory held by one resident cell.
+ * Assets referenced from several cells are charged to each of them, the total is an upper bound.
+ */
+struct FWorldGridStreamCellMemory
+{
+	int64 ActorBytes = 0;
+	int64 ComponentBytes = 0;
+	int64 AssetBytes = 0;
+
+	int64 GetTotalBytes() const { return ActorBytes + ComponentBytes + AssetBytes; }
+};
+
+/* * Runtime memory governor of UWorldGridStreamSubsystem.
+ * Tracks per-cell memory, detects pressure against the UWorldGridStreamConfigs budgets and picks the farthest cells to evict.
+ * While pressure persists the streaming radius scale shrinks step by step, it grows back once pressure is gone for a while.
+ */
+class FWorldGridStreamMemoryGovernor
+{
+	//Variable declarations
+public:
+protected:
+private:
+	TMap<FInt64Vector, FWorldGridStreamCellMemory> CellMemory;
+	int64 TrackedBytes = 0;
+
+	float RadiusScale = 1.0f;
+	float TimeWithoutPressure = 0.0f;
+	bool bUnderPressure = false;
+	int64 EvictionCount = 0;
+
+	//Function declarations
+public:
+	/* * Walks the cell's actors, their components and the assets they reference */
+	static WORLDGRIDSTREAM_API FWorldGridStreamCellMemory MeasureCell(const TArray<AActor*>& Actors);
+
+	WORLDGRIDSTREAM_API void SetCellMemory(const FInt64Vector& CellIndex, const FWorldGridStreamCellMemory& Memory);
+	void RemoveCell(const FInt64Vector& CellIndex);
+	const FWorldGridStreamCellMemory* FindCellMemory(const FInt64Vector& CellIndex) const { return CellMemory.Find(CellIndex); }
+	bool IsCellTracked(const FInt64Vector& CellIndex) const { return CellMemory.Contains(CellIndex); }
+	int32 GetNumTrackedCells() const { return CellMemory.Num(); }
+	int64 GetTrackedBytes() const { return TrackedBytes; }
+
+	/* * Bytes the tracked cells are over CellMemoryBudgetMB, 0 when within budget or unlimited */
+	int64 GetBytesOverBudget(const UWorldGridStreamConfigs& Configs) const;
+
+	/* * Samples pressure, cell budget or platform memory, and moves the radius scale. Returns true while under pressure */
+	bool UpdatePressure(const UWorldGridStreamConfigs& Configs, float DeltaTime);
+	bool IsUnderPressure() const { return bUnderPressure; }
+	float GetRadiusScale() const { return RadiusScale; }
+
+	/* * Farthest tracked cells first, cells closer than ProtectedDistance are never picked */
+	WORLDGRIDSTREAM_API void GatherEvictions(TFunctionRef<double(const FInt64Vector&)> GetCellDistance, double ProtectedDistance, int64 BytesToFree, int32 MaxCells, TArray<FInt64Vector>& OutCells) const;
+	void RecordEviction() { ++EvictionCount; }
+	int64 GetEvictionCount() const { return EvictionCount; }
+
+	void Reset();
+
+protected:
+private:
+};
@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class AActor;
+class UPrimitiveComponent;
+
+enum class EWorldGridStreamRegistrationPass : uint8
+{
+	Render,
+	Collision,
+	Navigation,
+	Num
+};
+
+WORLDGRIDSTREAM_API const TCHAR* LexToString(EWorldGridStreamRegistrationPass InPass);
+
+/* * Settings of a streamed primitive component held back until its registration pass runs */
+struct FWorldGridStreamDeferredComponent
+{
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+	TEnumAsByte<ECollisionEnabled::Type> CollisionEnabled = ECollisionEnabled::NoCollision;
+	bool bHiddenInGame = false;
+	bool bCanEverAffectNavigation = false;
+};
+
+/* * Component registration passes of activating cells.
+ * Streamed actors are spawned with their primitives hidden, without collision and out of navigation, see DeferComponents.
+ * Each pass then restores one of these per component within its own time budget per frame, nearest cell first,
+ * so nearby visuals appear first and distant collision and navigation follow over the next frames.
+ * FinishSpawning runs BeginPlay before any pass, so BeginPlay sees its primitives hidden and without collision.
+ * A pass only restores a value the component still holds from DeferComponents, changes made in BeginPlay or later are kept.
+ */
+class FWorldGridStreamRegistrationPasses
+{
+	//Variable declarations
+public:
+protected:
+private:
+	struct FCellPasses
+	{
+		FInt64Vector GridIndex = FInt64Vector::ZeroValue;
+		TArray<FWorldGridStreamDeferredComponent> Components;
+		int32 NextComponent[static_cast<int32>(EWorldGridStreamRegistrationPass::Num)] = {};
+		// No more components are added once the cell's actors are all spawned
+		bool bSpawned = false;
+
+		bool IsDone() const;
+	};
+	TArray<FCellPasses> Cells;
+
+	//Function declarations
+public:
+	/* * Before the actor's components are registered, holds back their render, collision and navigation state */
+	static void DeferComponents(AActor* InActor, TArray<FWorldGridStreamDeferredComponent>& OutComponents);
+
+	void AddComponents(const FInt64Vector& InGridIndex, TArray<FWorldGridStreamDeferredComponent>& InComponents);
+	void MarkSpawned(const FInt64Vector& InGridIndex);
+	void Cancel(const FInt64Vector& InGridIndex);
+	int32 GetNumPending(EWorldGridStreamRegistrationPass InPass) const;
+
+	/* * Runs each pass within its budget, at least one component per pass and frame. Cells done with every pass are appended to OutRegisteredCells */
+	void Tick(const double (&InBudgetSeconds)[static_cast<int32>(EWorldGridStreamRegistrationPass::Num)], TFunctionRef<double(const FInt64Vector&)> GetCellDistance, TFunctionRef<int32(const FInt64Vector&)> GetCellRing, TArray<FInt64Vector>& OutRegisteredCells);
+
+	void Reset() { Cells.Empty(); }
+
+protected:
+private:
+	FCellPasses& FindOrAddCell(const FInt64Vector& InGridIndex);
+	static void RunPass(EWorldGridStreamRegistrationPass InPass, const FWorldGridStreamDeferredComponent& InDeferred);
+};
@@ -52,6 +52,26 @@ public:
 	UPROPERTY(EditAnywhere, Category="World Grid Stream Settings", AdvancedDisplay, meta=(DisplayAfter="Streaming Off"))
 	bool bStreamingOn;
 
+	/* * Mid radius as a multiple of VisibilityDistance. Cells leaving VisibilityDistance stay resident but dormant up to it,
+	 * hidden, without collision and without tick, and are unloaded beyond it. 1.0 disables the dormant tier.
+	 * Default is set to 2.0f.
+	 */
+	UPROPERTY(EditAnywhere, Category="World Grid Stream Settings", meta=(ClampMin=1.0))
+	float DormantDistanceScale;
+
+	/* * Dormant cells also unregister their primitive components, freeing render and physics state at the cost of registering them again on wake.
+	 * Default is set to false.
+	 */
+	UPROPERTY(EditAnywhere, Category="World Grid Stream Settings", AdvancedDisplay)
+	bool bUnregisterDormantComponents;
+
+	/* * Collision radius as a multiple of VisibilityDistance. Cells beyond it stay visible with actor collision disabled and no physics state.
+	 * Players, their pawns and the registered collision guards are streaming sources, 0 keeps collision on every resident cell.
+	 * Default is set to 0.5f.
+	 */
+	UPROPERTY(EditAnywhere, Category="World Grid Stream Settings", meta=(ClampMin=0.0, ClampMax=1.0))
+	float CollisionDistanceScale;
+
 	/* * Landscape Scale ϰ  
 	 * ʿ ϸ鼭  .
 	 * Default is set to 100.0f.
@@ -100,6 +120,9 @@ public:
 	//~ End UObject Interface.
 
 	void SetWorldScale(float InWorldScale);
+	float GetDormantDistance() const { return VisibilityDistance * FMath::Max(DormantDistanceScale, 1.0f); }
+	bool IsCollisionStreamingEnabled() const { return CollisionDistanceScale > 0.0f && CollisionDistanceScale < 1.0f; }
+	float GetCollisionDistance() const { return VisibilityDistance * FMath::Clamp(CollisionDistanceScale, 0.0f, 1.0f); }
 	float GetWorldScale() { return WorldScale; }
 
 protected:
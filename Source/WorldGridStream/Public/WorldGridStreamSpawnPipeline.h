@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "WorldGridStreamRegistrationPasses.h"
+
+class UWorld;
+class AActor;
+class UWorldGridStreamInstances;
+
+/* * Everything needed to spawn one actor of a cell, prepared on a worker thread */
+struct FWorldGridStreamSpawnPrep
+{
+	TWeakObjectPtr<AActor> Template;
+	TWeakObjectPtr<UClass> ActorClass;
+	FTransform Transform = FTransform::Identity;
+};
+
+/* * Spawn pipeline of UWorldGridStreamSubsystem.
+ * Enqueued cells are prepared on a worker thread, classes resolved from ActorClassMaps and transforms read from the templates.
+ * The game thread spawns the prepared actors deferred and finishes them within a time budget per frame, nearest cell first.
+ * Their primitive components are handed to FWorldGridStreamRegistrationPasses before they are registered.
+ */
+class FWorldGridStreamSpawnPipeline
+{
+	//Variable declarations
+public:
+protected:
+private:
+	struct FCellSpawn
+	{
+		FInt64Vector GridIndex = FInt64Vector::ZeroValue;
+		TWeakObjectPtr<UWorldGridStreamInstances> Instances;
+		TArray<FWorldGridStreamSpawnPrep> Preps;
+		int32 NextPrep = 0;
+		UE::Tasks::FTask PrepTask;
+	};
+	TArray<TSharedRef<FCellSpawn>> Cells;
+
+	//Function declarations
+public:
+	/* * Launches the preparation of the cell's actors */
+	void Enqueue(const FInt64Vector& InGridIndex, UWorldGridStreamInstances* InInstances);
+	/* * Actors already spawned stay in the cell's SpawnedActors of the streaming context. Returns false when the cell was not queued */
+	bool Cancel(const FInt64Vector& InGridIndex);
+	bool Contains(const FInt64Vector& InGridIndex) const;
+	int32 GetNumCells() const { return Cells.Num(); }
+
+	/* * Finishes prepared actors until the budget is spent, at least one per frame. OnActorSpawned records the actor on the caller's side, before its components are handed to the passes.
+	 * Cells that are done are appended to OutSpawnedCells
+	 */
+	void Tick(UWorld* InWorld, double InBudgetSeconds, TFunctionRef<double(const FInt64Vector&)> GetCellDistance, TFunctionRef<int32(const FInt64Vector&)> GetCellRing, TFunctionRef<void(const FInt64Vector&, AActor*)> OnActorSpawned, FWorldGridStreamRegistrationPasses& InRegistrationPasses, TArray<FInt64Vector>& OutSpawnedCells);
+
+	void Reset();
+
+protected:
+private:
+};
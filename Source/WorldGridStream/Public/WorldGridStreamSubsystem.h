@@ -4,6 +4,13 @@
 
 #include "WorldGridStreamPrivate.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "WorldGridStreamMemoryGovernor.h"
+#include "WorldGridStreamGCScheduler.h"
+#include "WorldGridStreamContext.h"
+#include "WorldGridStreamSpawnPipeline.h"
+#include "WorldGridStreamDormancy.h"
+#include "WorldGridStreamTickThrottle.h"
+#include "WorldGridStreamCollisionStreaming.h"
 
 #include "WorldGridStreamSubsystem.generated.h"
 
@@ -18,6 +25,36 @@ protected:
 	TObjectPtr<class AWorldGridStreamSettings> WorldGridStreamSettings;
 
 	FDelegateHandle ActorSpawnedDelegateHandle;
+
+	FWorldGridStreamContext StreamingContext;
+
+	// Local player view points and, on listen servers, remote player pawns, gathered once per tick
+	TArray<FVector> StreamingSources;
+	// Every player's view point on servers, the streaming sources elsewhere. Only tick rings are measured from them
+	TArray<FVector> TickThrottleSources;
+
+	FWorldGridStreamMemoryGovernor MemoryGovernor;
+	float MemoryGovernorTime = 0.0f;
+
+	FWorldGridStreamGCScheduler GCScheduler;
+
+	FWorldGridStreamSpawnPipeline SpawnPipeline;
+	FWorldGridStreamRegistrationPasses RegistrationPasses;
+	FWorldGridStreamDormancy Dormancy;
+	FWorldGridStreamTickThrottle TickThrottle;
+	FWorldGridStreamCollisionStreaming CollisionStreaming;
+
+	// Streaming sources plus pawns and collision guards ahead of their velocity, gathered once per tick
+	TArray<FVector> CollisionSources;
+	TArray<TWeakObjectPtr<AActor>> CollisionGuards;
+
+	// Actors of Deactivating cells with their cell, destroyed oldest first within CellUnloadBudgetMS per frame. The actors of one cell are contiguous
+	TArray<TPair<FInt64Vector, TWeakObjectPtr<AActor>>> PendingDestroyActors;
+	int32 NextPendingDestroyActor = 0;
+
+	// Package loads issued and not completed yet, cancelled ones included
+	int32 InFlightCellLoads = 0;
+	uint32 CellLoadSerial = 0;
 private:
 
 public:
@@ -34,6 +71,10 @@ public:
 	virtual void Deinitialize() override;
 	// End USubsystem overrides
 
+	// Begin UWorldSubsystem overrides
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	// End UWorldSubsystem overrides
+
 	// Begin FTickableGameObject overrides
 	virtual void Tick(float DeltaTime) override;
 	virtual bool IsTickableInEditor() const override { return true; }
@@ -47,11 +88,61 @@ public:
 #endif //WITH_EDITOR
 
 	class AWorldGridStreamSettings* GetWorldGridStreamSettings() const;
+
+	/* * Cells within this distance of a streaming source should be resident. VisibilityDistance scaled down under memory pressure */
+	WORLDGRIDSTREAM_API double GetEffectiveStreamingRadius() const;
+	/* * Distance from the nearest streaming source to the cell's bounds, 0 for the cells containing a source */
+	WORLDGRIDSTREAM_API double GetDistanceToCell(const FInt64Vector& InGridIndex) const;
+	/* * Distance to the cell in cell sizes, 0 for the cells around the streaming sources */
+	WORLDGRIDSTREAM_API int32 GetCellRing(const FInt64Vector& InGridIndex) const;
+	const FWorldGridStreamMemoryGovernor& GetMemoryGovernor() const { return MemoryGovernor; }
+	const FWorldGridStreamGCScheduler& GetGCScheduler() const { return GCScheduler; }
+	FWorldGridStreamContext& GetStreamingContext() { return StreamingContext; }
+	const FWorldGridStreamContext& GetStreamingContext() const { return StreamingContext; }
+
+	/* * Queues the cell's actors for destruction and drops the cell from the instances map, the cell stays Deactivating until they are destroyed. The objects are collected later by the GC scheduler */
+	WORLDGRIDSTREAM_API bool UnloadCell(const FInt64Vector& InGridIndex);
+	/* * Cancels a Requested or Loading cell, unloads a resident one */
+	WORLDGRIDSTREAM_API void ReleaseCell(const FInt64Vector& InGridIndex);
+	int32 GetNumInFlightCellLoads() const { return InFlightCellLoads; }
+
+	/* * Fast movers such as projectiles and vehicles, cells around them and ahead of their velocity keep collision. Unregistering is optional, destroyed guards are dropped */
+	WORLDGRIDSTREAM_API void RegisterCollisionGuard(AActor* InActor);
+	WORLDGRIDSTREAM_API void UnregisterCollisionGuard(AActor* InActor);
+	/* * Distance from the nearest collision source to the cell's bounds */
+	WORLDGRIDSTREAM_API double GetCollisionDistanceToCell(const FInt64Vector& InGridIndex) const;
+	const FWorldGridStreamCollisionStreaming& GetCollisionStreaming() const { return CollisionStreaming; }
 	
 protected:
 #if WITH_EDITOR
 	void OnMapChanged(UWorld* InWorld, EMapChangeType ChangeType);
 #endif //WITH_EDITOR
 	void OnActorSpawned(AActor* InSpawnedActor);
+
+	void GatherStreamingSources();
+	void GatherTickThrottleSources();
+	void GatherCollisionSources();
+	void UpdateMemoryGovernor(float DeltaTime);
+	/* * Tracks the resident cells the streamer did not load, saved in the map or built in the editor, as Active */
+	void TrackResidentCells();
+	/* * Maps the actors saved in the map to the cells at their location as Active cells. Dedicated servers do not stream, their ticks are throttled on these */
+	void MapPlacedActors(UWorld& InWorld);
+	double GetDistanceToCell(const FInt64Vector& InGridIndex, const TArray<FVector>& InSources) const;
+
+	/* * Requests the cells entering the streaming radius, releases the ones leaving it and issues the nearest requests */
+	void UpdateCellStreaming();
+	void RequestCellsAround(const FVector& InSource, double InRadius);
+	void LoadCell(const FInt64Vector& InGridIndex, double InDistance);
+	void OnCellPackageLoaded(const FName& InPackageName, UPackage* InLoadedPackage, EAsyncLoadingResult::Type InResult, FInt64Vector InGridIndex, uint32 InLoadSerial);
+	/* * Hands the loaded cells to the spawn pipeline, runs the registration passes and activates the cells done with them */
+	void ActivateLoadedCells();
+	/* * Unloads the farthest dormant cells while the dormant tier is over its caps */
+	void EnforceDormantCaps();
+	/* * Moves active cells to the tick ring of their distance to the tick throttle sources */
+	void UpdateTickThrottle();
+	/* * Destroys queued actors of Deactivating cells until the budget is spent, at least one per frame. A cell is Unloaded once its last actor is destroyed */
+	void DestroyPendingActors();
+	/* * Disables the collision of cells leaving the collision radius, enables the nearest ones entering it within the budget */
+	void UpdateCollisionStreaming();
 private:
 };
@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+
+/* * Distance based tick throttling of UWorldGridStreamSubsystem.
+ * Active cells are assigned a ring, their distance in cells to the nearest streaming source. Each ring has a tick interval
+ * from UWorldGridStreamConfigs::RingTickIntervals, rings past the end of the list or with a negative interval do not tick.
+ * A ring change is applied to the cell's actors and components over StaggerFrames frames so their ticks do not line up.
+ */
+class FWorldGridStreamTickThrottle
+{
+	//Variable declarations
+public:
+protected:
+private:
+	struct FThrottledObject
+	{
+		// AActor or UActorComponent
+		TWeakObjectPtr<UObject> Object;
+		float OriginalTickInterval = 0.0f;
+		bool bSuspended = false;
+	};
+	struct FThrottledCell
+	{
+		int32 Ring = INDEX_NONE;
+		TArray<FThrottledObject> Objects;
+	};
+	TMap<FInt64Vector, FThrottledCell> Cells;
+
+	struct FPendingUpdate
+	{
+		FInt64Vector GridIndex = FInt64Vector::ZeroValue;
+		int32 ObjectIndex = 0;
+		uint64 DueFrame = 0;
+	};
+	TArray<FPendingUpdate> PendingUpdates;
+
+	//Function declarations
+public:
+	/* * The first call captures the ticking actors and components of the cell's actors that are in a world */
+	WORLDGRIDSTREAM_API void SetCellRing(const FInt64Vector& InGridIndex, const TArray<AActor*>& InActors, int32 InRing, int32 InStaggerFrames);
+	/* * Puts back the original tick intervals and resumes suspended ticks, before the cell goes dormant or is unloaded */
+	WORLDGRIDSTREAM_API void RestoreCell(const FInt64Vector& InGridIndex);
+	int32 GetCellRing(const FInt64Vector& InGridIndex) const;
+	WORLDGRIDSTREAM_API int32 GetNumSuspended() const;
+
+	/* * Applies the updates due this frame */
+	WORLDGRIDSTREAM_API void Tick(const TArray<float>& InRingTickIntervals);
+
+	void Reset();
+
+protected:
+private:
+	static void ApplyRing(FThrottledObject& InThrottledObject, int32 InRing, const TArray<float>& InRingTickIntervals);
+};
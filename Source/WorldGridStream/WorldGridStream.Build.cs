@@ -39,6 +39,8 @@ public class WorldGridStream : ModuleRules
 			new string[]
 			{
 				"Landscape",
+				"DeveloperSettings",
+				"AssetRegistry",
 			}
 		);
 
@@ -48,9 +50,7 @@ public class WorldGridStream : ModuleRules
 				new string[]
 				{
 					"UnrealEd",
-					"AssetRegistry",
 					"SourceControl",
-					"DeveloperSettings",
 				}
 			);
 		}
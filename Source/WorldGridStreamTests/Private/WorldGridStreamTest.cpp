@@ -0,0 +1,249 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/StaticMeshActor.h"
+#include "WorldGridStreamConfigs.h"
+#include "WorldGridStreamContext.h"
+#include "WorldGridStreamGCScheduler.h"
+#include "WorldGridStreamMemoryGovernor.h"
+#include "WorldGridStreamSettings.h"
+#include "WorldGridStreamSubsystem.h"
+#include "WorldGridStreamTickThrottle.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldGridStreamContext_StateTest, "WorldGridStream.Basic.CellStates", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FWorldGridStreamContext_StateTest::RunTest(const FString& Parameters)
+{
+	using EState = EWorldGridStreamCellState;
+
+	// Forward path, dormancy and cancellation
+	TestTrue(TEXT("Unloaded -> Requested"), FWorldGridStreamContext::IsValidTransition(EState::Unloaded, EState::Requested));
+	TestTrue(TEXT("Loading -> Unloaded"), FWorldGridStreamContext::IsValidTransition(EState::Loading, EState::Unloaded));
+	TestTrue(TEXT("Active -> Dormant"), FWorldGridStreamContext::IsValidTransition(EState::Active, EState::Dormant));
+	TestTrue(TEXT("Dormant -> Active"), FWorldGridStreamContext::IsValidTransition(EState::Dormant, EState::Active));
+	TestTrue(TEXT("Dormant -> Deactivating"), FWorldGridStreamContext::IsValidTransition(EState::Dormant, EState::Deactivating));
+	TestTrue(TEXT("Deactivating -> Unloaded"), FWorldGridStreamContext::IsValidTransition(EState::Deactivating, EState::Unloaded));
+
+	// Skipped states and activated cells leaving without deactivating
+	TestFalse(TEXT("Unloaded -> Loading"), FWorldGridStreamContext::IsValidTransition(EState::Unloaded, EState::Loading));
+	TestFalse(TEXT("Requested -> Loaded"), FWorldGridStreamContext::IsValidTransition(EState::Requested, EState::Loaded));
+	TestFalse(TEXT("Active -> Unloaded"), FWorldGridStreamContext::IsValidTransition(EState::Active, EState::Unloaded));
+	TestFalse(TEXT("Deactivating -> Active"), FWorldGridStreamContext::IsValidTransition(EState::Deactivating, EState::Active));
+	TestFalse(TEXT("Unloaded -> Unloaded"), FWorldGridStreamContext::IsValidTransition(EState::Unloaded, EState::Unloaded));
+
+	FWorldGridStreamContext Context;
+	const FInt64Vector GridIndex(1, 2, 0);
+
+	TestTrue(TEXT("Request the cell"), Context.SetCellState(GridIndex, EState::Requested));
+	TestEqual(TEXT("Requested count"), Context.GetNumCellsInState(EState::Requested), 1);
+	TestTrue(TEXT("Load the cell"), Context.SetCellState(GridIndex, EState::Loading));
+	TestEqual(TEXT("Requested count after leaving"), Context.GetNumCellsInState(EState::Requested), 0);
+	TestEqual(TEXT("Loading count"), Context.GetNumCellsInState(EState::Loading), 1);
+	TestEqual(TEXT("Requested exit count"), Context.GetStateTiming(EState::Requested).ExitCount, 1);
+	TestTrue(TEXT("Cell state"), Context.GetCellState(GridIndex) == EState::Loading);
+
+	// An invalid transition leaves the cell and the counters as they are
+	AddExpectedError(TEXT("Invalid state transition"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Loading -> Active is refused"), Context.SetCellState(GridIndex, EState::Active));
+	TestTrue(TEXT("Cell state after a refused transition"), Context.GetCellState(GridIndex) == EState::Loading);
+	TestEqual(TEXT("Active count after a refused transition"), Context.GetNumCellsInState(EState::Active), 0);
+
+	// Cancelling removes the cell, unloaded cells are not stored
+	TestTrue(TEXT("Cancel the cell"), Context.SetCellState(GridIndex, EState::Unloaded));
+	TestNull(TEXT("Unloaded cell is removed"), Context.FindCell(GridIndex));
+	TestEqual(TEXT("Loading count after cancelling"), Context.GetNumCellsInState(EState::Loading), 0);
+	TestEqual(TEXT("Loading exit count"), Context.GetStateTiming(EState::Loading).ExitCount, 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldGridStreamMemoryGovernor_EvictionTest, "WorldGridStream.Basic.GatherEvictions", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FWorldGridStreamMemoryGovernor_EvictionTest::RunTest(const FString& Parameters)
+{
+	// Cells 1 to 5 along X, each 1000 away per index and holding 100 bytes
+	FWorldGridStreamMemoryGovernor MemoryGovernor;
+	FWorldGridStreamCellMemory CellMemory;
+	CellMemory.ActorBytes = 100;
+	for (int64 X = 1; X <= 5; ++X)
+	{
+		MemoryGovernor.SetCellMemory(FInt64Vector(X, 0, 0), CellMemory);
+	}
+	auto GetCellDistance = [](const FInt64Vector& InGridIndex)
+	{
+		return static_cast<double>(InGridIndex.X) * 1000.0;
+	};
+
+	TArray<FInt64Vector> Evictions;
+	MemoryGovernor.GatherEvictions(GetCellDistance, 0.0, 0, 10, Evictions);
+	TestEqual(TEXT("Every cell without a byte target"), Evictions.Num(), 5);
+	if (Evictions.Num() == 5)
+	{
+		TestEqual(TEXT("Farthest cell first"), Evictions[0].X, static_cast<int64>(5));
+		TestEqual(TEXT("Nearest cell last"), Evictions[4].X, static_cast<int64>(1));
+	}
+
+	Evictions.Reset();
+	MemoryGovernor.GatherEvictions(GetCellDistance, 3000.0, 0, 10, Evictions);
+	TestEqual(TEXT("Cells within the protected distance are kept"), Evictions.Num(), 2);
+	TestFalse(TEXT("Cell at the protected distance is kept"), Evictions.Contains(FInt64Vector(3, 0, 0)));
+
+	Evictions.Reset();
+	MemoryGovernor.GatherEvictions(GetCellDistance, 0.0, 150, 10, Evictions);
+	TestEqual(TEXT("Stops once the byte target is freed"), Evictions.Num(), 2);
+
+	Evictions.Reset();
+	MemoryGovernor.GatherEvictions(GetCellDistance, 0.0, 0, 3, Evictions);
+	TestEqual(TEXT("Stops at MaxCells"), Evictions.Num(), 3);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldGridStreamGCScheduler_HoldTest, "WorldGridStream.Basic.GCScheduling", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FWorldGridStreamGCScheduler_HoldTest::RunTest(const FString& Parameters)
+{
+	const UWorldGridStreamConfigs* Configs = GetDefault<UWorldGridStreamConfigs>();
+	if (Configs->GetGCMaxDebtSeconds() <= 1.0f)
+	{
+		AddWarning(TEXT("GCMaxDebtSeconds is too short to hold a collection, skipped"));
+		return true;
+	}
+
+	FWorldGridStreamGCScheduler GCScheduler;
+	const int32 Debt = Configs->GetGCDebtThreshold() + 1;
+	GCScheduler.AddDebt(Debt);
+	GCScheduler.BeginMaterialization();
+
+	// Over the threshold, but a cell is being materialized
+	GCScheduler.Tick(*Configs, 1.0f);
+	TestEqual(TEXT("Debt is held while materializing"), GCScheduler.GetDebt(), Debt);
+	TestFalse(TEXT("No collection while materializing"), GCScheduler.IsCollecting());
+	TestEqual(TEXT("No collection count while materializing"), GCScheduler.GetCollectionCount(), 0);
+
+	// The debt aged past GCMaxDebtSeconds, the hold no longer applies
+	GCScheduler.Tick(*Configs, Configs->GetGCMaxDebtSeconds());
+	TestEqual(TEXT("Stale debt is paid while materializing"), GCScheduler.GetDebt(), 0);
+
+	// Let a started collection finish within the test
+	for (int32 Step = 0; Step < 10000 && true == GCScheduler.IsCollecting(); ++Step)
+	{
+		GCScheduler.Tick(*Configs, 0.0f);
+	}
+	TestFalse(TEXT("Collection finished"), GCScheduler.IsCollecting());
+	GCScheduler.EndMaterialization();
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldGridStreamTickThrottle_RingTest, "WorldGridStream.Basic.TickThrottle", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FWorldGridStreamTickThrottle_RingTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	if (false == TestNotNull(TEXT("World"), World))
+	{
+		return false;
+	}
+
+	AActor* Actor = World->SpawnActor<AActor>();
+	if (false == TestNotNull(TEXT("Actor"), Actor))
+	{
+		World->DestroyWorld(false);
+		return false;
+	}
+	Actor->PrimaryActorTick.bCanEverTick = true;
+	Actor->SetActorTickInterval(0.2f);
+	Actor->SetActorTickEnabled(true);
+
+	// Ring 1 asks for less than the actor's own interval, ring 2 for more, ring 3 is past the list and does not tick
+	const TArray<float> RingTickIntervals = { 0.0f, 0.1f, 0.5f };
+	const FInt64Vector GridIndex(0, 0, 0);
+	const TArray<AActor*> Actors = { Actor };
+	FWorldGridStreamTickThrottle TickThrottle;
+
+	TickThrottle.SetCellRing(GridIndex, Actors, 1, 1);
+	TickThrottle.Tick(RingTickIntervals);
+	TestEqual(TEXT("Interval is never lowered"), Actor->GetActorTickInterval(), 0.2f);
+
+	TickThrottle.SetCellRing(GridIndex, Actors, 2, 1);
+	TickThrottle.Tick(RingTickIntervals);
+	TestEqual(TEXT("Interval is raised"), Actor->GetActorTickInterval(), 0.5f);
+
+	TickThrottle.SetCellRing(GridIndex, Actors, 3, 1);
+	TickThrottle.Tick(RingTickIntervals);
+	TestFalse(TEXT("Tick is suspended past the rings"), Actor->IsActorTickEnabled());
+	TestEqual(TEXT("Suspended count"), TickThrottle.GetNumSuspended(), 1);
+
+	TickThrottle.SetCellRing(GridIndex, Actors, 0, 1);
+	TickThrottle.Tick(RingTickIntervals);
+	TestTrue(TEXT("Tick is resumed"), Actor->IsActorTickEnabled());
+	TestEqual(TEXT("Interval after resuming"), Actor->GetActorTickInterval(), 0.2f);
+	TestEqual(TEXT("Suspended count after resuming"), TickThrottle.GetNumSuspended(), 0);
+
+	TickThrottle.SetCellRing(GridIndex, Actors, 3, 1);
+	TickThrottle.Tick(RingTickIntervals);
+	TickThrottle.RestoreCell(GridIndex);
+	TestTrue(TEXT("Tick is resumed on restore"), Actor->IsActorTickEnabled());
+	TestEqual(TEXT("Interval after restore"), Actor->GetActorTickInterval(), 0.2f);
+
+	World->DestroyWorld(false);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWorldGridStreamSubsystem_DedicatedServerTickTest, "WorldGridStream.Basic.DedicatedServerTickThrottle", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FWorldGridStreamSubsystem_DedicatedServerTickTest::RunTest(const FString& Parameters)
+{
+	const UWorldGridStreamConfigs* Configs = GetDefault<UWorldGridStreamConfigs>();
+	if (false == Configs->ShouldThrottleTicks())
+	{
+		AddWarning(TEXT("bThrottleTicks is off, skipped"));
+		return true;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::PIE, false);
+	if (false == TestNotNull(TEXT("World"), World))
+	{
+		return false;
+	}
+	World->SetPlayInEditorInitialNetMode(NM_DedicatedServer);
+	UWorldGridStreamSubsystem* Subsystem = World->GetSubsystem<UWorldGridStreamSubsystem>();
+	if (false == TestTrue(TEXT("World is a dedicated server"), World->IsNetMode(NM_DedicatedServer)) || false == TestNotNull(TEXT("Subsystem"), Subsystem))
+	{
+		World->DestroyWorld(false);
+		return false;
+	}
+
+	AWorldGridStreamSettings* Settings = World->SpawnActor<AWorldGridStreamSettings>();
+	Settings->bStreamingOn = true;
+	Settings->VisibilityDistance = 1000.0f;
+
+	// The only player stands at the origin, one actor shares its cell and one is far past the last tick ring
+	World->SpawnActor<APlayerController>(FVector::ZeroVector, FRotator::ZeroRotator);
+	const auto SpawnTicking = [World](const FVector& InLocation)
+	{
+		AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(InLocation, FRotator::ZeroRotator);
+		Actor->PrimaryActorTick.bCanEverTick = true;
+		Actor->SetActorTickInterval(0.05f);
+		Actor->SetActorTickEnabled(true);
+		return Actor;
+	};
+	AStaticMeshActor* NearActor = SpawnTicking(FVector(100.0, 100.0, 0.0));
+	AStaticMeshActor* FarActor = SpawnTicking(FVector(1000.0 * (Configs->GetRingTickIntervals().Num() + 10), 100.0, 0.0));
+
+	Subsystem->OnWorldBeginPlay(*World);
+	Subsystem->Tick(0.0f);
+
+	const EWorldGridStreamCellState FarCellState = Subsystem->GetStreamingContext().GetCellState(FInt64Vector(Configs->GetRingTickIntervals().Num() + 10, 0, 0));
+	TestTrue(TEXT("Placed actors are mapped to Active cells"), FarCellState == EWorldGridStreamCellState::Active);
+	TestTrue(TEXT("Near actor keeps ticking"), NearActor->IsActorTickEnabled());
+	TestEqual(TEXT("Near actor keeps its interval"), NearActor->GetActorTickInterval(), 0.05f);
+	TestTrue(TEXT("Far actor is throttled"), false == FarActor->IsActorTickEnabled() || FarActor->GetActorTickInterval() > 0.05f);
+
+	World->DestroyWorld(false);
+	return true;
+}
@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using System.IO;
+using UnrealBuildTool;
+
+// Automation tests of WorldGridStream, editor only so none of it ships
+public class WorldGridStreamTests : ModuleRules
+{
+	public WorldGridStreamTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// WorldGridStreamSubsystem.h includes the runtime module's private header
+		PrivateIncludePaths.Add(Path.Combine(ModuleDirectory, "..", "WorldGridStream", "Private"));
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"DeveloperSettings",
+				"WorldGridStream",
+			}
+		);
+	}
+}